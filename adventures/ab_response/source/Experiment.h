@@ -26,6 +26,7 @@
 #include "tools/string_utils.h"
 
 #include "../../utility_belt/source/utilities.h"
+#include "../../utility_belt/source/InstructionSets.h"
 
 #include "ab_resp-config.h"
 
@@ -64,6 +65,7 @@ public:
   using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
   using state_t = hardware_t::State;
   using program_t = hardware_t::Program;
+  using program_pool_t = toolbelt::ObjectPool<program_t>;
   using function_t = hardware_t::Function;
   using inst_t = hardware_t::inst_t;
   using inst_lib_t = hardware_t::inst_lib_t;
@@ -82,16 +84,18 @@ public:
   /// Agent to be evolved.
   struct Agent {
     size_t agent_id;
-    program_t program;
+    toolbelt::Pooled<program_t> program;   ///< Recycled through the experiment's program pool.
 
-    Agent(const program_t & _p) : agent_id(0), program(_p) { ; }
-    Agent(const Agent && in) : agent_id(in.GetID()), program(in.program) { ; }
-    Agent(const Agent & in): agent_id(in.GetID()), program(in.program) { ; }
+    Agent(const program_t & _p, emp::Ptr<program_pool_t> pool=nullptr) : agent_id(0), program(_p, pool) { ; }
+    Agent(const Agent & in) = default;
+    Agent(Agent && in) noexcept = default;
+    Agent & operator=(const Agent & in) = default;
+    Agent & operator=(Agent && in) noexcept = default;
 
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
 
-    program_t & GetGenome() { return program; }
+    program_t & GetGenome() { return program.Get(); }
   };
 
   struct Phenotype {
@@ -206,11 +210,15 @@ protected:
   // Experiment member variables. 
   emp::Ptr<emp::Random> random;     ///< Random number generator
   emp::Ptr<world_t> world;          ///< Empirical world for evolution
+  program_pool_t program_pool;      ///< Recycled program storage for agents
 
   emp::Ptr<inst_lib_t> inst_lib;    ///< SignalGP instruction library
   emp::Ptr<event_lib_t> event_lib;  ///< SignalGP event library
 
+  emp::Ptr<emp::Random> eval_random;     ///< Random number generator used during evaluation
+  toolbelt::RandomStreams eval_streams;  ///< Per-(generation, agent, evaluation) random number streams
   emp::Ptr<hardware_t> eval_hw;     ///< SignalGP virtual hardware used for evaluation
+  toolbelt::TagMatchCache<hardware_t> match_cache; ///< Memoized tag lookups for program on eval_hw
 
   toolbelt::SignalGPMutator<hardware_t> mutator;
 
@@ -256,7 +264,19 @@ protected:
   emp::Signal<void(void)> reset_signal_mapping_change_trial_sig;
 
   void Evaluate(agent_t & agent) {
-    // TODO: write evaluate function
+    const size_t genotype_hash = toolbelt::HashProgram(agent.GetGenome());
+    for (eval_id = 0; eval_id < EVALUATION_CNT; ++eval_id) {
+      // Each evaluation gets its own random number stream (identical genotypes get identical streams).
+      eval_streams.SeedStream(*eval_random, update, genotype_hash, eval_id);
+      begin_agent_eval_sig.Trigger(agent);
+      for (trial_id = 0; trial_id < TRIAL_CNT; ++trial_id) {
+        // TODO: change signal-response mapping at switch_trial_by_eval[eval_id]
+        begin_agent_trial_sig.Trigger(agent);
+        do_agent_trial_sig.Trigger(agent);
+        end_agent_trial_sig.Trigger(agent);
+      }
+      end_agent_eval_sig.Trigger(agent);
+    }
   }
 
   /// Scratch/test function. 
@@ -370,7 +390,9 @@ public:
     // Make empty instruction/event libraries
     inst_lib = emp::NewPtr<inst_lib_t>();
     event_lib = emp::NewPtr<event_lib_t>();
-    eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, random);
+    eval_random = emp::NewPtr<emp::Random>((int)random->GetUInt(1, 2147483647));
+    eval_streams.SetBaseSeed(random->GetUInt());
+    eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, eval_random);
 
     // Configure the mutator
     mutator.SetProgMinFuncCnt(SGP_PROG_MIN_FUNC_CNT);
@@ -410,6 +432,7 @@ public:
 
   ~Experiment() {
     eval_hw.Delete();
+    eval_random.Delete();
     event_lib.Delete();
     inst_lib.Delete();
     world.Delete();
@@ -446,7 +469,6 @@ public:
   // -- Execution control instructions (that make use of function regulation) --
   static void Inst_Call(hardware_t & hw, const inst_t & inst);      
   static void Inst_Fork(hardware_t & hw, const inst_t & inst);      
-  static void Inst_Terminate(hardware_t & hw, const inst_t & inst); 
   // -- Sensor instructions --
 
   // === SGP event handlers/dispatchers ===
@@ -465,12 +487,6 @@ void Experiment::Inst_Fork(hardware_t & hw, const inst_t & inst) {
   hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem, false, true);
 }
 
-void Experiment::Inst_Terminate(hardware_t & hw, const inst_t & inst)  {
-  // Pop all the call states from current core.
-  exec_stk_t & core = hw.GetCurCore();
-  core.resize(0);
-}
-
 // ================== Run experiment implementations ==================
 void Experiment::Run() {
   switch (RUN_MODE) {
@@ -512,7 +528,7 @@ void Experiment::InitPopulation__FromAncestorFile() {
   std::cout << " --- Ancestor program: ---" << std::endl;
   ancestor_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
-  world->Inject(ancestor_prog, POP_SIZE);    // Inject population!
+  world->Inject(agent_t(ancestor_prog, &program_pool), POP_SIZE);    // Inject population!
 }
 
 void Experiment::GenerateSignalTags__FromTagFile() {
@@ -581,7 +597,7 @@ void Experiment::Snapshot__Programs(size_t u) {
     if (!world->IsOccupied(i)) continue;
     prog_ofstream << "==="<<i<<":"<<world->CalcFitnessID(i)<<"===\n";
     Agent & agent = world->GetOrg(i);
-    agent.program.PrintProgramFull(prog_ofstream);
+    agent.GetGenome().PrintProgramFull(prog_ofstream);
   }
   prog_ofstream.close();
 }
@@ -601,35 +617,11 @@ double Experiment::CalcFitness(agent_t & agent) {
 void Experiment::DoConfig__Hardware() {
   // Setup the instruction set
   // - Standard instructions
-  inst_lib->AddInst("Inc", hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
-  inst_lib->AddInst("Dec", hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
-  inst_lib->AddInst("Not", hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
-  inst_lib->AddInst("Add", hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
-  inst_lib->AddInst("Sub", hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
-  inst_lib->AddInst("Mult", hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
-  inst_lib->AddInst("Div", hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
-  inst_lib->AddInst("Mod", hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
-  inst_lib->AddInst("TestEqu", hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
-  inst_lib->AddInst("TestNEqu", hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
-  inst_lib->AddInst("TestLess", hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
-  inst_lib->AddInst("If", hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("While", hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Countdown", hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Close", hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
-  inst_lib->AddInst("Break", hardware_t::Inst_Break, 0, "Break out of current block.");
-  inst_lib->AddInst("Return", hardware_t::Inst_Return, 0, "Return from current function if possible.");
-  inst_lib->AddInst("SetMem", hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
-  inst_lib->AddInst("CopyMem", hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
-  inst_lib->AddInst("SwapMem", hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
-  inst_lib->AddInst("Input", hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
-  inst_lib->AddInst("Output", hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
-  inst_lib->AddInst("Commit", hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Pull", hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Nop", hardware_t::Inst_Nop, 0, "No operation.");
+  toolbelt::AddStandardInstructions<hardware_t>(*inst_lib);
 
   inst_lib->AddInst("Call", Inst_Call, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
   inst_lib->AddInst("Fork", Inst_Fork, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.", emp::ScopeType::BASIC, 0, {"affinity"});
-  inst_lib->AddInst("Terminate", Inst_Terminate, 0, "Kill current thread.");
+  inst_lib->AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
 
   // TODO: any experiment-specific instructions
 
@@ -637,57 +629,13 @@ void Experiment::DoConfig__Hardware() {
   switch(REF_MOD_ADJUSTMENT_TYPE) {
     case REF_MOD_ADJUSTMENT_TYPE_ID__ADD: {
       // When applying regulation to a function's reference modifier, do so by adding/subtracting ref mod adjustment value.
-
-      inst_lib->AddInst("Promote", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod + REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Up regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
-      inst_lib->AddInst("Repress", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod - REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Down regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
+      toolbelt::AddRegulationInstructions<hardware_t>(*inst_lib, match_cache, REF_MOD_ADJUSTMENT_VALUE, false, MODIFY_REG);
       break;
     }
     case REF_MOD_ADJUSTMENT_TYPE_ID__MULT: {
 
       emp_assert(REF_MOD_ADJUSTMENT_VALUE != 0);
-
-      inst_lib->AddInst("Promote", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod * REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Up regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
-      inst_lib->AddInst("Repress", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod * (1/REF_MOD_ADJUSTMENT_VALUE));
-      }, 0, "Down regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-      
+      toolbelt::AddRegulationInstructions<hardware_t>(*inst_lib, match_cache, REF_MOD_ADJUSTMENT_VALUE, true, MODIFY_REG);
       break;
     }
     default: {
@@ -776,6 +724,7 @@ void Experiment::DoConfig__Experiment() {
       our_hero.SetID(id);
       // Take care of one-time stuff for this evaluation.
       eval_hw->SetProgram(our_hero.GetGenome());
+      match_cache.Clear();
       // Evaluate!
       this->Evaluate(our_hero);
       // TODO: configure representative phenotype!
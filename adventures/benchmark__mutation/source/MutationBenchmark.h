@@ -0,0 +1,240 @@
+#ifndef MUTATION_BENCHMARK_H
+#define MUTATION_BENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <fstream>
+#include <chrono>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "hardware/InstLib.h"
+#include "tools/Random.h"
+#include "tools/math.h"
+#include "tools/string_utils.h"
+
+#include "../../utility_belt/source/utilities.h"
+
+#include "mutation_throughput-config.h"
+
+constexpr size_t TAG_WIDTH = 16;
+
+/// MutationBenchmark measures toolbelt::SignalGPMutator throughput in legacy mode (one random draw
+/// per tag bit/substitution site/instruction; functions rebuilt when mutated) and in the default
+/// mode (skip-sampled per-bit/per-instruction mutations; functions mutated in place).
+///  - Both modes mutate copies of the same random population, generation after generation, with
+///    each offspring's random number stream keyed by (generation, program ID).
+///  - Only ApplyMutations calls are timed.
+///  - Results are written as JSON.
+class MutationBenchmark {
+public:
+  using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
+  using program_t = hardware_t::Program;
+  using function_t = hardware_t::Function;
+  using inst_lib_t = hardware_t::inst_lib_t;
+  using tag_t = hardware_t::affinity_t;
+  using mutator_t = toolbelt::SignalGPMutator<hardware_t>;
+
+  /// Results for a single mutation mode (summed over replicates).
+  struct Result {
+    std::string mode;
+    size_t offspring;
+    size_t mutations;
+    size_t final_inst_cnt;   ///< Total instructions in final population (summed over replicates).
+    double elapsed_sec;
+
+    Result() : mode(), offspring(0), mutations(0), final_inst_cnt(0), elapsed_sec(0.0) { ; }
+  };
+
+protected:
+  // Localized configs
+  int RANDOM_SEED;
+  size_t REPLICATES;
+  std::string OUTPUT_FPATH;
+
+  size_t POP_SIZE;
+  size_t GENERATIONS;
+  size_t INST_SET_SIZE;
+
+  size_t SGP_PROG_MAX_FUNC_CNT;
+  size_t SGP_PROG_MIN_FUNC_CNT;
+  size_t SGP_PROG_MAX_FUNC_LEN;
+  size_t SGP_PROG_MIN_FUNC_LEN;
+  size_t SGP_PROG_MAX_TOTAL_LEN;
+
+  int SGP_MUT_PROG_MAX_ARG_VAL;
+  double SGP_MUT_PER_BIT__TAG_BFLIP_RATE;
+  double SGP_MUT_PER_INST__SUB_RATE;
+  double SGP_MUT_PER_INST__INS_RATE;
+  double SGP_MUT_PER_INST__DEL_RATE;
+  double SGP_MUT_PER_FUNC__SLIP_RATE;
+  double SGP_MUT_PER_FUNC__FUNC_DUP_RATE;
+  double SGP_MUT_PER_FUNC__FUNC_DEL_RATE;
+
+  emp::Ptr<emp::Random> random;
+  emp::Ptr<inst_lib_t> inst_lib;
+
+  mutator_t mutator;
+  toolbelt::RandomStreams mut_streams;
+
+  emp::vector<Result> results;
+
+  void GenerateRandomPrograms(emp::vector<program_t> & programs);
+  Result RunMode(bool legacy, const emp::vector<program_t> & init_pop);
+  void PrintResults(std::ostream & os) const;
+
+public:
+  MutationBenchmark(const MutationThroughputConfig & config)
+    : random(), inst_lib(), mutator(), mut_streams(), results()
+  {
+    RANDOM_SEED = config.RANDOM_SEED();
+    REPLICATES = config.REPLICATES();
+    OUTPUT_FPATH = config.OUTPUT_FPATH();
+    POP_SIZE = config.POP_SIZE();
+    GENERATIONS = config.GENERATIONS();
+    INST_SET_SIZE = config.INST_SET_SIZE();
+    SGP_PROG_MAX_FUNC_CNT = config.SGP_PROG_MAX_FUNC_CNT();
+    SGP_PROG_MIN_FUNC_CNT = config.SGP_PROG_MIN_FUNC_CNT();
+    SGP_PROG_MAX_FUNC_LEN = config.SGP_PROG_MAX_FUNC_LEN();
+    SGP_PROG_MIN_FUNC_LEN = config.SGP_PROG_MIN_FUNC_LEN();
+    SGP_PROG_MAX_TOTAL_LEN = config.SGP_PROG_MAX_TOTAL_LEN();
+    SGP_MUT_PROG_MAX_ARG_VAL = config.SGP_MUT_PROG_MAX_ARG_VAL();
+    SGP_MUT_PER_BIT__TAG_BFLIP_RATE = config.SGP_MUT_PER_BIT__TAG_BFLIP_RATE();
+    SGP_MUT_PER_INST__SUB_RATE = config.SGP_MUT_PER_INST__SUB_RATE();
+    SGP_MUT_PER_INST__INS_RATE = config.SGP_MUT_PER_INST__INS_RATE();
+    SGP_MUT_PER_INST__DEL_RATE = config.SGP_MUT_PER_INST__DEL_RATE();
+    SGP_MUT_PER_FUNC__SLIP_RATE = config.SGP_MUT_PER_FUNC__SLIP_RATE();
+    SGP_MUT_PER_FUNC__FUNC_DUP_RATE = config.SGP_MUT_PER_FUNC__FUNC_DUP_RATE();
+    SGP_MUT_PER_FUNC__FUNC_DEL_RATE = config.SGP_MUT_PER_FUNC__FUNC_DEL_RATE();
+
+    random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+    mut_streams.SetBaseSeed(random->GetUInt());
+
+    // Mutation only cares about instruction set size.
+    inst_lib = emp::NewPtr<inst_lib_t>();
+    for (size_t i = 0; i < INST_SET_SIZE; ++i) {
+      inst_lib->AddInst("Nop-" + emp::to_string(i), hardware_t::Inst_Nop, 0, "No operation.");
+    }
+
+    mutator.SetProgMinFuncCnt(SGP_PROG_MIN_FUNC_CNT);
+    mutator.SetProgMaxFuncCnt(SGP_PROG_MAX_FUNC_CNT);
+    mutator.SetProgMinFuncLen(SGP_PROG_MIN_FUNC_LEN);
+    mutator.SetProgMaxFuncLen(SGP_PROG_MAX_FUNC_LEN);
+    mutator.SetProgMaxTotalLen(SGP_PROG_MAX_TOTAL_LEN);
+    mutator.SetProgMaxArgVal(SGP_MUT_PROG_MAX_ARG_VAL);
+    mutator.SetPerBitTagBitFlipRate(SGP_MUT_PER_BIT__TAG_BFLIP_RATE);
+    mutator.SetPerInstSubRate(SGP_MUT_PER_INST__SUB_RATE);
+    mutator.SetPerInstInsRate(SGP_MUT_PER_INST__INS_RATE);
+    mutator.SetPerInstDelRate(SGP_MUT_PER_INST__DEL_RATE);
+    mutator.SetPerFuncSlipRate(SGP_MUT_PER_FUNC__SLIP_RATE);
+    mutator.SetPerFuncDupRate(SGP_MUT_PER_FUNC__FUNC_DUP_RATE);
+    mutator.SetPerFuncDelRate(SGP_MUT_PER_FUNC__FUNC_DEL_RATE);
+  }
+
+  ~MutationBenchmark() {
+    inst_lib.Delete();
+    random.Delete();
+  }
+
+  void Run();
+};
+
+/// Generate a random population.
+void MutationBenchmark::GenerateRandomPrograms(emp::vector<program_t> & programs) {
+  programs.clear();
+  for (size_t i = 0; i < POP_SIZE; ++i) {
+    programs.emplace_back(inst_lib);
+    program_t & prog = programs.back();
+    const size_t fcnt = random->GetUInt(SGP_PROG_MIN_FUNC_CNT, SGP_PROG_MAX_FUNC_CNT + 1);
+    for (size_t fID = 0; fID < fcnt; ++fID) {
+      function_t new_fun;
+      new_fun.affinity.Randomize(*random);
+      const size_t icnt = random->GetUInt(SGP_PROG_MIN_FUNC_LEN, SGP_PROG_MAX_FUNC_LEN + 1);
+      for (size_t iID = 0; iID < icnt; ++iID) {
+        new_fun.PushInst(random->GetUInt(inst_lib->GetSize()),
+                         random->GetInt(SGP_MUT_PROG_MAX_ARG_VAL),
+                         random->GetInt(SGP_MUT_PROG_MAX_ARG_VAL),
+                         random->GetInt(SGP_MUT_PROG_MAX_ARG_VAL),
+                         tag_t());
+        new_fun.inst_seq.back().affinity.Randomize(*random);
+      }
+      prog.PushFunction(new_fun);
+    }
+  }
+}
+
+/// Mutate copies of the initial population for GENERATIONS generations (REPLICATES times).
+MutationBenchmark::Result MutationBenchmark::RunMode(bool legacy, const emp::vector<program_t> & init_pop) {
+  Result result;
+  result.mode = (legacy) ? "legacy" : "skip_sampling";
+  mutator.SetLegacyMode(legacy);
+  emp::Random rnd(1);
+  for (size_t rep = 0; rep < REPLICATES; ++rep) {
+    emp::vector<program_t> pop(init_pop);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t gen = 0; gen < GENERATIONS; ++gen) {
+      for (size_t id = 0; id < pop.size(); ++id) {
+        result.mutations += mutator.ApplyMutations(pop[id], rnd, mut_streams, gen, id);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.elapsed_sec += std::chrono::duration<double>(end - start).count();
+    result.offspring += GENERATIONS * pop.size();
+    for (const program_t & prog : pop) result.final_inst_cnt += prog.GetInstCnt();
+  }
+  std::cerr << "  " << result.mode << ": " << result.offspring << " offspring, " << result.mutations
+            << " mutations in " << result.elapsed_sec << "s" << std::endl;
+  return result;
+}
+
+void MutationBenchmark::Run() {
+  results.clear();
+  emp::vector<program_t> init_pop;
+  GenerateRandomPrograms(init_pop);
+  std::cerr << "Benchmarking SignalGP mutation" << std::endl;
+  results.emplace_back(RunMode(true, init_pop));
+  results.emplace_back(RunMode(false, init_pop));
+
+  if (OUTPUT_FPATH == "") {
+    PrintResults(std::cout);
+  } else {
+    std::ofstream out_fstream(OUTPUT_FPATH);
+    if (!out_fstream.is_open()) {
+      std::cerr << "Failed to open output file (" << OUTPUT_FPATH << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+    PrintResults(out_fstream);
+  }
+}
+
+void MutationBenchmark::PrintResults(std::ostream & os) const {
+  auto per_sec = [](size_t cnt, double sec) { return (sec > 0.0) ? ((double)cnt / sec) : 0.0; };
+  os << std::setprecision(10);
+  os << "{\n";
+  os << "  \"benchmark\": \"mutation_throughput\",\n";
+  os << "  \"random_seed\": " << RANDOM_SEED << ",\n";
+  os << "  \"pop_size\": " << POP_SIZE << ",\n";
+  os << "  \"generations\": " << GENERATIONS << ",\n";
+  os << "  \"replicates\": " << REPLICATES << ",\n";
+  os << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result & r = results[i];
+    os << ((i) ? ",\n" : "\n");
+    os << "    {";
+    os << "\"mode\": \"" << r.mode << "\", ";
+    os << "\"offspring\": " << r.offspring << ", ";
+    os << "\"mutations\": " << r.mutations << ", ";
+    os << "\"mutations_per_offspring\": " << ((r.offspring) ? ((double)r.mutations / r.offspring) : 0.0) << ", ";
+    os << "\"mean_final_program_len\": " << ((REPLICATES && POP_SIZE) ? ((double)r.final_inst_cnt / (REPLICATES * POP_SIZE)) : 0.0) << ", ";
+    os << "\"elapsed_sec\": " << r.elapsed_sec << ", ";
+    os << "\"offspring_per_sec\": " << per_sec(r.offspring, r.elapsed_sec) << ", ";
+    os << "\"mutations_per_sec\": " << per_sec(r.mutations, r.elapsed_sec);
+    os << "}";
+  }
+  os << "\n  ]\n";
+  os << "}" << std::endl;
+}
+
+#endif
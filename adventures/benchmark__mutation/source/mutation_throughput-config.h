@@ -0,0 +1,32 @@
+#ifndef MUTATION_THROUGHPUT_CONFIG_H
+#define MUTATION_THROUGHPUT_CONFIG_H
+
+#include "config/config.h"
+
+EMP_BUILD_CONFIG( MutationThroughputConfig,
+  GROUP(DEFAULT_GROUP, "General Settings"),
+  VALUE(RANDOM_SEED, int, 1, "Random number seed (negative value for based on time)"),
+  VALUE(REPLICATES, size_t, 3, "How many times should we run each mode?"),
+  VALUE(OUTPUT_FPATH, std::string, "", "Where should we write JSON results? (empty for stdout)"),
+  GROUP(WORKLOAD_GROUP, "Workload Settings"),
+  VALUE(POP_SIZE, size_t, 1000, "How many programs are mutated per generation?"),
+  VALUE(GENERATIONS, size_t, 100, "How many rounds of mutation? (each round mutates every program)"),
+  VALUE(INST_SET_SIZE, size_t, 32, "Size of (no-op) instruction set to mutate over"),
+  GROUP(PROGRAM_GROUP, "Program Settings"),
+  VALUE(SGP_PROG_MAX_FUNC_CNT, size_t, 8, "Used for generating SGP programs. How many functions do we generate?"),
+  VALUE(SGP_PROG_MIN_FUNC_CNT, size_t, 1, "Used for generating SGP programs. How many functions do we generate?"),
+  VALUE(SGP_PROG_MAX_FUNC_LEN, size_t, 8, ".."),
+  VALUE(SGP_PROG_MIN_FUNC_LEN, size_t, 1, ".."),
+  VALUE(SGP_PROG_MAX_TOTAL_LEN, size_t, 256, "Maximum length of SGP programs."),
+  GROUP(MUTATION_GROUP, "Mutation Settings (defaults match env_coordination)"),
+  VALUE(SGP_MUT_PROG_MAX_ARG_VAL, int, 16, "Maximum argument value for instructions."),
+  VALUE(SGP_MUT_PER_BIT__TAG_BFLIP_RATE, double, 0.005, "Per-bit mutation rate of tag bit flips."),
+  VALUE(SGP_MUT_PER_INST__SUB_RATE, double, 0.005, "Per-instruction/argument substitution rate."),
+  VALUE(SGP_MUT_PER_INST__INS_RATE, double, 0.005, "Per-instruction insertion mutation rate."),
+  VALUE(SGP_MUT_PER_INST__DEL_RATE, double, 0.005, "Per-instruction deletion mutation rate."),
+  VALUE(SGP_MUT_PER_FUNC__SLIP_RATE, double, 0.05, "Per-function rate of slip mutations."),
+  VALUE(SGP_MUT_PER_FUNC__FUNC_DUP_RATE, double, 0.05, "Per-function rate of function duplications."),
+  VALUE(SGP_MUT_PER_FUNC__FUNC_DEL_RATE, double, 0.05, "Per-function rate of function deletions.")
+)
+
+#endif
@@ -0,0 +1,34 @@
+// This is the main function for the NATIVE version of this project.
+
+#include <iostream>
+
+#include "config/command_line.h"
+#include "config/ArgManager.h"
+
+#include "../mutation_throughput-config.h"
+#include "../MutationBenchmark.h"
+
+int main(int argc, char* argv[])
+{
+  // Read configs.
+  std::string config_fname = "configs.cfg";
+  auto args = emp::cl::ArgManager(argc, argv);
+  MutationThroughputConfig config;
+  config.Read(config_fname);
+
+  if (args.ProcessConfigOptions(config, std::cout, config_fname, "../mutation_throughput-config.h") == false)
+    exit(0);
+  if (args.TestUnknown() == false)
+    exit(0);
+
+  // Configuration goes to stderr so that stdout is (only) JSON results.
+  std::cerr << "==============================" << std::endl;
+  std::cerr << "|    How am I configured?    |" << std::endl;
+  std::cerr << "==============================" << std::endl;
+  config.Write(std::cerr);
+  std::cerr << "==============================\n"
+            << std::endl;
+
+  MutationBenchmark bench(config);
+  bench.Run();
+}
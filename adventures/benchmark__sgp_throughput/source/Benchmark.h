@@ -0,0 +1,762 @@
+#ifndef SGP_THROUGHPUT_BENCHMARK_H
+#define SGP_THROUGHPUT_BENCHMARK_H
+
+// includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <fstream>
+#include <functional>
+#include <chrono>
+#include <unordered_set>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "hardware/InstLib.h"
+#include "tools/Random.h"
+#include "tools/math.h"
+#include "tools/string_utils.h"
+
+#include "../../utility_belt/source/utilities.h"
+#include "../../utility_belt/source/InstructionSets.h"
+#include "../../t_maze/source/TMaze.h"
+
+#include "sgp_throughput-config.h"
+
+// Globals
+constexpr size_t SETUP_ID__ENV_COORDINATION = 0;
+constexpr size_t SETUP_ID__T_MAZE = 1;
+constexpr size_t SETUP_ID__DIV_OF_LABOR = 2;
+constexpr size_t SETUP_ID__AB_RESPONSE = 3;
+constexpr size_t SETUP_CNT = 4;
+
+// Handcoded t_maze solutions were written with 16-bit tags, so every setup runs at that width.
+constexpr size_t TAG_WIDTH = 16;
+
+constexpr size_t TRAIT_CNT = 8;
+// - env_coordination
+constexpr size_t TRAIT_ID__STATE = 0;
+// - t_maze
+constexpr size_t TRAIT_ID__LOC = 0;
+constexpr size_t TRAIT_ID__FACING = 1;
+constexpr size_t TRAIT_ID__LAST_ACTION = 2;
+constexpr size_t TRAIT_ID__REWARD_VALUE = 3;
+constexpr size_t TRAIT_ID__COLLIDED = 4;
+// - div_of_labor
+constexpr size_t TRAIT_ID__DIR = 0;
+constexpr size_t TRAIT_ID__ROLE_ID = 1;
+
+constexpr size_t DOL_NUM_DIRS = 4;
+
+/// Benchmark measures SignalGP interpreter throughput for the hardware setups configured by the
+/// env_coordination, t_maze, div_of_labor, and ab_response adventures.
+///  - Each setup's instruction set mirrors that adventure's DoConfig__Hardware (the standard and
+///    regulation instructions come from the same toolbelt code; Call/Fork/event handlers use the
+///    same matching code paths). Instructions that touch an adventure's environment (maze, deme,
+///    task set) operate on a small stand-in environment held by the benchmark.
+///  - Each setup runs twice: a timed pass with unwrapped instructions, then a counting pass (same
+///    programs and random draws) with every instruction and event handler wrapped to count
+///    executions. Results combine the timed pass's elapsed time with the counting pass's counts.
+///  - Results are written as JSON.
+class Benchmark {
+public:
+  using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
+  using program_t = hardware_t::Program;
+  using state_t = hardware_t::State;
+  using function_t = hardware_t::Function;
+  using inst_t = hardware_t::inst_t;
+  using inst_lib_t = hardware_t::inst_lib_t;
+  using event_t = hardware_t::event_t;
+  using event_lib_t = hardware_t::event_lib_t;
+  using memory_t = hardware_t::memory_t;
+  using tag_t = hardware_t::affinity_t;
+  using exec_stk_t = hardware_t::exec_stk_t;
+
+  using inst_fun_t = std::function<void(hardware_t &, const inst_t &)>;
+  using event_fun_t = std::function<void(hardware_t &, const event_t &)>;
+  using task_io_t = uint32_t;
+
+  /// Execution counts accumulated over a single workload.
+  struct Counts {
+    size_t single_process_calls;
+    size_t insts;
+    size_t events;
+    size_t spawns;
+    size_t programs;
+    double elapsed_sec;
+
+    Counts() : single_process_calls(0), insts(0), events(0), spawns(0), programs(0), elapsed_sec(0.0) { ; }
+  };
+
+  /// Results for a single (setup, workload) pair.
+  struct Result {
+    std::string setup;
+    std::string workload;
+    size_t inst_set_size;
+    Counts counts;
+  };
+
+  /// Stands in for the current setup's instruction library when building instruction sets with
+  /// toolbelt code: instructions are wrapped to count executions (on counting passes) and added.
+  class InstLibBuilder {
+  protected:
+    Benchmark & bench;
+
+  public:
+    InstLibBuilder(Benchmark & _bench) : bench(_bench) { ; }
+
+    void AddInst(const std::string & name, const inst_fun_t & fun, size_t num_args, const std::string & desc) {
+      bench.inst_lib->AddInst(name, bench.WrapInst(fun), num_args, desc);
+    }
+
+    void AddInst(const std::string & name, const inst_fun_t & fun, size_t num_args, const std::string & desc,
+                 emp::ScopeType scope_type, size_t scope_arg, const std::unordered_set<std::string> & properties) {
+      bench.inst_lib->AddInst(name, bench.WrapInst(fun), num_args, desc, scope_type, scope_arg, properties);
+    }
+  };
+
+protected:
+  // Localized configs
+  int RANDOM_SEED;
+  emp::vector<size_t> SETUPS;
+  size_t REPLICATES;
+  std::string OUTPUT_FPATH;
+
+  size_t EVAL_TIME;
+  size_t EVENT_INTERVAL;
+  size_t RANDOM_PROGRAM_CNT;
+  size_t PROG_MIN_FUNC_CNT;
+  size_t PROG_MAX_FUNC_CNT;
+  size_t PROG_MIN_FUNC_LEN;
+  size_t PROG_MAX_FUNC_LEN;
+  int PROG_MAX_ARG_VAL;
+
+  emp::vector<std::string> HANDCODED_PROGRAMS;  ///< Indexed by setup ID.
+
+  size_t SGP_HW_MAX_CORES;
+  size_t SGP_HW_MAX_CALL_DEPTH;
+  double SGP_HW_MIN_BIND_THRESH;
+  bool SGP_HW_EVENT_DRIVEN;
+  size_t ENVIRONMENT_STATES;
+  double REF_MOD_ADJUSTMENT_VALUE;
+  bool MODIFY_REG;
+
+  emp::Ptr<emp::Random> random;
+
+  bool count_execs;   ///< Is this a counting pass? (Wrap instructions/events to count executions.)
+
+  emp::Ptr<inst_lib_t> inst_lib;
+  emp::Ptr<event_lib_t> event_lib;
+  emp::Ptr<hardware_t> eval_hw;
+
+  toolbelt::TagMatchCache<hardware_t> match_cache;
+
+  // Stand-in environment state.
+  size_t env_state;
+  emp::vector<tag_t> env_tags;
+  emp::vector<task_io_t> task_inputs;
+  size_t input_load_id;
+  size_t submissions;
+
+  Counts counts;
+  emp::vector<Result> results;
+
+  std::function<void()> begin_eval_fun;         ///< Called once program is loaded and hardware is reset.
+  std::function<void(size_t)> env_step_fun;     ///< Called every EVENT_INTERVAL time steps.
+
+  static std::string GetSetupName(size_t setup_id);
+
+  inst_fun_t WrapInst(const inst_fun_t & fun);
+  void AddInst(const std::string & name, const inst_fun_t & fun, size_t num_args, const std::string & desc,
+               const std::unordered_set<std::string> & properties=std::unordered_set<std::string>());
+  void AddEvent(const std::string & name, const event_fun_t & fun, const std::string & desc);
+
+  void ConfigSetup(size_t setup_id);
+  void ConfigSetup__EnvCoordination();
+  void ConfigSetup__TMaze();
+  void ConfigSetup__DivOfLabor();
+  void ConfigSetup__ABResponse();
+  void ConfigSetup__Regulation();
+  void CleanupSetup();
+
+  void GenerateRandomPrograms(emp::vector<program_t> & programs);
+  void LoadPrograms(const std::string & fpaths, emp::vector<program_t> & programs);
+
+  void EvalProgram(const program_t & program);
+  Result RunWorkload(size_t setup_id, const std::string & workload, const emp::vector<program_t> & programs);
+  void RunSetup(size_t setup_id, bool count, emp::vector<Result> & setup_results);
+
+  void PrintResults(std::ostream & os) const;
+
+public:
+  Benchmark(const SGPThroughputConfig & config)
+    : random(), count_execs(false), inst_lib(), event_lib(), eval_hw(), match_cache(),
+      env_state(0), env_tags(), task_inputs(), input_load_id(0), submissions(0),
+      counts(), results()
+  {
+    RANDOM_SEED = config.RANDOM_SEED();
+    REPLICATES = config.REPLICATES();
+    OUTPUT_FPATH = config.OUTPUT_FPATH();
+    EVAL_TIME = config.EVAL_TIME();
+    EVENT_INTERVAL = config.EVENT_INTERVAL();
+    RANDOM_PROGRAM_CNT = config.RANDOM_PROGRAM_CNT();
+    PROG_MIN_FUNC_CNT = config.PROG_MIN_FUNC_CNT();
+    PROG_MAX_FUNC_CNT = config.PROG_MAX_FUNC_CNT();
+    PROG_MIN_FUNC_LEN = config.PROG_MIN_FUNC_LEN();
+    PROG_MAX_FUNC_LEN = config.PROG_MAX_FUNC_LEN();
+    PROG_MAX_ARG_VAL = config.PROG_MAX_ARG_VAL();
+    SGP_HW_MAX_CORES = config.SGP_HW_MAX_CORES();
+    SGP_HW_MAX_CALL_DEPTH = config.SGP_HW_MAX_CALL_DEPTH();
+    SGP_HW_MIN_BIND_THRESH = config.SGP_HW_MIN_BIND_THRESH();
+    SGP_HW_EVENT_DRIVEN = config.SGP_HW_EVENT_DRIVEN();
+    ENVIRONMENT_STATES = config.ENVIRONMENT_STATES();
+    REF_MOD_ADJUSTMENT_VALUE = config.REF_MOD_ADJUSTMENT_VALUE();
+    MODIFY_REG = config.MODIFY_REG();
+
+    HANDCODED_PROGRAMS.resize(SETUP_CNT);
+    HANDCODED_PROGRAMS[SETUP_ID__ENV_COORDINATION] = config.ENV_COORDINATION_PROGRAMS();
+    HANDCODED_PROGRAMS[SETUP_ID__T_MAZE] = config.T_MAZE_PROGRAMS();
+    HANDCODED_PROGRAMS[SETUP_ID__DIV_OF_LABOR] = config.DIV_OF_LABOR_PROGRAMS();
+    HANDCODED_PROGRAMS[SETUP_ID__AB_RESPONSE] = config.AB_RESPONSE_PROGRAMS();
+
+    emp::vector<std::string> setup_strs;
+    emp::slice(config.SETUPS(), setup_strs, ',');
+    for (const std::string & setup_str : setup_strs) {
+      if (setup_str.empty()) continue;
+      const size_t setup_id = emp::from_string<size_t>(setup_str);
+      if (setup_id >= SETUP_CNT) {
+        std::cerr << "Unrecognized setup ID (" << setup_id << "). Exiting..." << std::endl;
+        exit(-1);
+      }
+      SETUPS.emplace_back(setup_id);
+    }
+
+    if (EVENT_INTERVAL == 0) {
+      std::cerr << "EVENT_INTERVAL must be greater than 0. Exiting..." << std::endl;
+      exit(-1);
+    }
+
+    random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+  }
+
+  ~Benchmark() {
+    CleanupSetup();
+    random.Delete();
+  }
+
+  /// Run all configured setups/workloads and output results.
+  void Run();
+
+  const emp::vector<Result> & GetResults() const { return results; }
+};
+
+std::string Benchmark::GetSetupName(size_t setup_id) {
+  switch (setup_id) {
+    case SETUP_ID__ENV_COORDINATION: return "env_coordination";
+    case SETUP_ID__T_MAZE: return "t_maze";
+    case SETUP_ID__DIV_OF_LABOR: return "div_of_labor";
+    case SETUP_ID__AB_RESPONSE: return "ab_response";
+    default: return "unknown";
+  }
+}
+
+/// On counting passes, wrap instruction to count executions. (Otherwise, instruction is unchanged.)
+Benchmark::inst_fun_t Benchmark::WrapInst(const inst_fun_t & fun) {
+  if (!count_execs) return fun;
+  return [this, fun](hardware_t & hw, const inst_t & inst) {
+    ++counts.insts;
+    fun(hw, inst);
+  };
+}
+
+/// Add instruction to current instruction library (wrapped to count executions on counting passes).
+void Benchmark::AddInst(const std::string & name, const inst_fun_t & fun, size_t num_args, const std::string & desc,
+                        const std::unordered_set<std::string> & properties) {
+  inst_lib->AddInst(name, WrapInst(fun), num_args, desc, emp::ScopeType::BASIC, 0, properties);
+}
+
+/// Add event to current event library (wrapped to count handled events on counting passes).
+void Benchmark::AddEvent(const std::string & name, const event_fun_t & fun, const std::string & desc) {
+  if (!count_execs) {
+    event_lib->AddEvent(name, fun, desc);
+    return;
+  }
+  event_lib->AddEvent(name, [this, fun](hardware_t & hw, const event_t & event) {
+    ++counts.events;
+    fun(hw, event);
+  }, desc);
+}
+
+void Benchmark::CleanupSetup() {
+  if (eval_hw) eval_hw.Delete();
+  if (inst_lib) inst_lib.Delete();
+  if (event_lib) event_lib.Delete();
+  eval_hw = nullptr;
+  inst_lib = nullptr;
+  event_lib = nullptr;
+}
+
+/// Build instruction/event libraries and evaluation hardware for given setup.
+void Benchmark::ConfigSetup(size_t setup_id) {
+  CleanupSetup();
+  // Every setup starts from the same random state so results don't depend on which setups run.
+  random->ResetSeed(RANDOM_SEED);
+  inst_lib = emp::NewPtr<inst_lib_t>();
+  event_lib = emp::NewPtr<event_lib_t>();
+  eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, random);
+  begin_eval_fun = [](){ ; };
+  env_step_fun = [](size_t){ ; };
+
+  switch (setup_id) {
+    case SETUP_ID__ENV_COORDINATION: ConfigSetup__EnvCoordination(); break;
+    case SETUP_ID__T_MAZE: ConfigSetup__TMaze(); break;
+    case SETUP_ID__DIV_OF_LABOR: ConfigSetup__DivOfLabor(); break;
+    case SETUP_ID__AB_RESPONSE: ConfigSetup__ABResponse(); break;
+    default: {
+      std::cerr << "Unrecognized setup ID (" << setup_id << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+  }
+
+  eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
+  eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
+  eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+}
+
+void Benchmark::ConfigSetup__EnvCoordination() {
+  InstLibBuilder inst_builder(*this);
+  toolbelt::AddStandardInstructions<hardware_t>(inst_builder, hardware_t::Inst_Call);
+  AddInst("Fork", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    size_t fID;
+    ++counts.spawns;
+    if (match_cache.FindFunction(hw, inst.affinity, hw.GetMinBindThresh(), false, fID)) {
+      hw.SpawnCore(fID, state.local_mem, false);
+    }
+  }, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.");
+  AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
+
+  // Tasks (stand-in task set: inputs are fixed, submissions are only counted).
+  AddInst("Load-1", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], task_inputs[input_load_id]);
+    input_load_id += 1;
+    if (input_load_id >= task_inputs.size()) input_load_id = 0;
+  }, 1, "WM[ARG1] = TaskInput[LOAD_ID]; LOAD_ID++;");
+  AddInst("Load-2", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], task_inputs[0]);
+    state.SetLocal(inst.args[1], task_inputs[1]);
+  }, 2, "WM[ARG1] = TASKINPUT[0]; WM[ARG2] = TASKINPUT[1];");
+  AddInst("Submit", [this](hardware_t & hw, const inst_t & inst) {
+    submissions += (size_t)(hw.GetTrait(TRAIT_ID__STATE) == env_state);
+  }, 1, "Submit WM[ARG1] as potential task solution.");
+  AddInst("Nand", toolbelt::Inst_Nand<hardware_t, task_io_t>, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
+
+  for (size_t i = 0; i < ENVIRONMENT_STATES; ++i) {
+    AddInst("SetState-" + emp::to_string(i), [i](hardware_t & hw, const inst_t & inst) {
+      hw.SetTrait(TRAIT_ID__STATE, i);
+    }, 0, "Set internal state to " + emp::to_string(i));
+  }
+
+  if (SGP_HW_EVENT_DRIVEN) {
+    AddEvent("EnvSignal", [this](hardware_t & hw, const event_t & event) {
+      size_t fID;
+      ++counts.spawns;
+      if (match_cache.FindFunction(hw, event.affinity, hw.GetMinBindThresh(), false, fID)) {
+        hw.SpawnCore(fID, event.msg, false);
+      }
+    }, "");
+    event_lib->RegisterDispatchFun("EnvSignal", [](hardware_t & hw, const event_t & event) { hw.QueueEvent(event); });
+  } else {
+    AddEvent("EnvSignal", [](hardware_t & hw, const event_t & event) { return; }, "");
+    event_lib->RegisterDispatchFun("EnvSignal", [](hardware_t & hw, const event_t & event) { return; });
+  }
+
+  for (size_t i = 0; i < ENVIRONMENT_STATES; ++i) {
+    AddInst("SenseState-" + emp::to_string(i), [this, i](hardware_t & hw, const inst_t & inst) {
+      state_t & state = hw.GetCurState();
+      state.SetLocal(inst.args[0], env_state == i);
+    }, 1, "Sense if current environment state is " + emp::to_string(i));
+  }
+
+  env_tags = toolbelt::GenerateRandomTags<TAG_WIDTH>(*random, ENVIRONMENT_STATES, true);
+  task_inputs.resize(2);
+
+  begin_eval_fun = [this]() {
+    env_state = 0;
+    input_load_id = 0;
+    task_inputs[0] = random->GetUInt();
+    task_inputs[1] = random->GetUInt();
+    eval_hw->TriggerEvent("EnvSignal", env_tags[env_state]);
+  };
+
+  env_step_fun = [this](size_t t) {
+    env_state = random->GetUInt(ENVIRONMENT_STATES);
+    eval_hw->TriggerEvent("EnvSignal", env_tags[env_state]);
+  };
+}
+
+void Benchmark::ConfigSetup__TMaze() {
+  InstLibBuilder inst_builder(*this);
+  toolbelt::AddStandardInstructions<hardware_t>(inst_builder);
+  AddInst("Call", [](hardware_t & hw, const inst_t & inst) {
+    hw.CallFunction(inst.affinity, hw.GetMinBindThresh(), true);
+  }, 0, "Call function that best matches call affinity.", {"affinity"});
+  AddInst("Fork", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    ++counts.spawns;
+    hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem, false, true);
+  }, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.", {"affinity"});
+  AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
+
+  // Actuation (stand-in maze: moving forward walks through cell types).
+  AddInst("Forward", [](hardware_t & hw, const inst_t & inst) {
+    if (hw.GetTrait(TRAIT_ID__LAST_ACTION)) return;
+    hw.SetTrait(TRAIT_ID__LOC, emp::Mod((int)hw.GetTrait(TRAIT_ID__LOC) + 1, (int)TMaze::NUM_CELL_TYPES));
+    hw.SetTrait(TRAIT_ID__LAST_ACTION, 1);
+  }, 0, "If the agent can move forward, move the agent forward in the maze. Otherwise, collision!");
+  AddInst("RotCW", [](hardware_t & hw, const inst_t & inst) {
+    if (hw.GetTrait(TRAIT_ID__LAST_ACTION)) return;
+    hw.SetTrait(TRAIT_ID__FACING, emp::Mod((int)hw.GetTrait(TRAIT_ID__FACING) + 1, (int)TMaze::NUM_DIRECTIONS));
+    hw.SetTrait(TRAIT_ID__LAST_ACTION, 2);
+  }, 0, "Rotate agent clockwise.");
+  AddInst("RotCCW", [](hardware_t & hw, const inst_t & inst) {
+    if (hw.GetTrait(TRAIT_ID__LAST_ACTION)) return;
+    hw.SetTrait(TRAIT_ID__FACING, emp::Mod((int)hw.GetTrait(TRAIT_ID__FACING) - 1, (int)TMaze::NUM_DIRECTIONS));
+    hw.SetTrait(TRAIT_ID__LAST_ACTION, 3);
+  }, 0, "Rotate agent counter-clockwise.");
+
+  // Sensors
+  AddInst("GetCorridorLen", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], 3);
+  }, 1, "WM[ARG0] = CORRIDOR LENGTH");
+  AddInst("GetHeading", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], hw.GetTrait(TRAIT_ID__FACING));
+  }, 1, "WM[ARG0] = current heading (N=0, E=1, S=2, or W=3)");
+  AddInst("IsNorth", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], TMaze::N == TMaze::GetFacing(hw.GetTrait(TRAIT_ID__FACING)));
+  }, 1, "WM[ARG0] = Is current facing North?");
+  AddInst("IsEast", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], TMaze::E == TMaze::GetFacing(hw.GetTrait(TRAIT_ID__FACING)));
+  }, 1, "WM[ARG0] = Is current facing East?");
+  AddInst("IsWest", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], TMaze::W == TMaze::GetFacing(hw.GetTrait(TRAIT_ID__FACING)));
+  }, 1, "WM[ARG0] = Is current facing West?");
+  AddInst("IsSouth", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], TMaze::S == TMaze::GetFacing(hw.GetTrait(TRAIT_ID__FACING)));
+  }, 1, "WM[ARG0] = Is current facing South?");
+  AddInst("GetRewardValue", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], hw.GetTrait(TRAIT_ID__REWARD_VALUE));
+  }, 1, "WM[ARG0] = currently collected reward value");
+  for (size_t loc_id = 0; loc_id < TMaze::NUM_CELL_TYPES; ++loc_id) {
+    TMaze::CellType cell_type = TMaze::GetCellType(loc_id);
+    AddInst("IsLocType-"+TMaze::CellTypeToString(cell_type), [loc_id](hardware_t & hw, const inst_t & inst) {
+      state_t & state = hw.GetCurState();
+      state.SetLocal(inst.args[0], (int)(loc_id == hw.GetTrait(TRAIT_ID__LOC)));
+    }, 1, "WM[ARG0] = Is current location of type " + emp::to_string(loc_id) + "?");
+  }
+
+  ConfigSetup__Regulation();
+
+  AddEvent("MazeLocation", [this](hardware_t & hw, const event_t & event) {
+    ++counts.spawns;
+    hw.SpawnCore(event.affinity, hw.GetMinBindThresh(), event.msg, false, true);
+  }, "Maze location event. Triggered when agent moves onto new location.");
+  event_lib->RegisterDispatchFun("MazeLocation", [](hardware_t & hw, const event_t & event) { hw.QueueEvent(event); });
+
+  env_tags = toolbelt::GenerateRandomTags<TAG_WIDTH>(*random, TMaze::NUM_CELL_TYPES, true);
+
+  begin_eval_fun = [this]() {
+    eval_hw->TriggerEvent("MazeLocation", env_tags[TMaze::GetCellType(TMaze::CellType::START)]);
+  };
+
+  // Each event interval is one action opportunity.
+  env_step_fun = [this](size_t t) {
+    eval_hw->SetTrait(TRAIT_ID__LAST_ACTION, 0);
+    eval_hw->TriggerEvent("MazeLocation", env_tags[(size_t)eval_hw->GetTrait(TRAIT_ID__LOC)]);
+  };
+}
+
+void Benchmark::ConfigSetup__DivOfLabor() {
+  InstLibBuilder inst_builder(*this);
+  toolbelt::AddStandardInstructions<hardware_t>(inst_builder, hardware_t::Inst_Call);
+  AddInst("Fork", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    ++counts.spawns;
+    hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem);
+  }, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.");
+  AddInst("Nand", toolbelt::Inst_Nand<hardware_t, task_io_t>, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
+  AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
+
+  // Tasks (stand-in task set: inputs are fixed, submissions are only counted).
+  AddInst("Load-1", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], task_inputs[input_load_id]);
+    input_load_id += 1;
+    if (input_load_id >= task_inputs.size()) input_load_id = 0;
+  }, 1, "WM[ARG1] = TaskInput[LOAD_ID]; LOAD_ID++;");
+  AddInst("Load-2", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], task_inputs[0]);
+    state.SetLocal(inst.args[1], task_inputs[1]);
+  }, 2, "WM[ARG1] = TASKINPUT[0]; WM[ARG2] = TASKINPUT[1];");
+  AddInst("Submit", [this](hardware_t & hw, const inst_t & inst) {
+    ++submissions;
+  }, 1, "Submit WM[ARG1] as potential task solution.");
+
+  // Stand-in deme has a single member, so activating a neighbor does nothing.
+  AddInst("ActivateFacing", [](hardware_t & hw, const inst_t & inst) { return; }, 0, "Activate faced neighbor.");
+
+  AddInst("RotCW", [](hardware_t & hw, const inst_t & inst) {
+    hw.SetTrait(TRAIT_ID__DIR, emp::Mod((int)hw.GetTrait(TRAIT_ID__DIR) - 1, (int)DOL_NUM_DIRS));
+  }, 0, "Rotate clockwise");
+  AddInst("RotCCW", [](hardware_t & hw, const inst_t & inst) {
+    hw.SetTrait(TRAIT_ID__DIR, emp::Mod((int)hw.GetTrait(TRAIT_ID__DIR) + 1, (int)DOL_NUM_DIRS));
+  }, 0, "Rotate couter-clockwise");
+  AddInst("GetDir", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], hw.GetTrait(TRAIT_ID__DIR));
+  }, 0, "WM[ARG1]=CURRENT DIRECTION");
+
+  AddInst("GetRoleID", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], hw.GetTrait(TRAIT_ID__ROLE_ID));
+  }, 1, "WM[ARG1]=TRAITS[ROLE_ID]");
+  AddInst("SetRoleID", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    hw.SetTrait(TRAIT_ID__ROLE_ID, state.GetLocal(inst.args[0]));
+  }, 1, "TRAITS[ROLE_ID]=WM[ARG1]");
+
+  AddInst("GetLocXY", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], 0);
+    state.SetLocal(inst.args[1], 0);
+  }, 2, "WM[ARG1]=LOCX, WM[ARG2]=LOCY");
+
+  AddInst("SendMsg", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    hw.TriggerEvent("SendMessage", inst.affinity, state.output_mem);
+  }, 0, "Send output memory as message event to faced neighbor.", {"affinity"});
+  AddInst("BroadcastMsg", [](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    hw.TriggerEvent("BroadcastMessage", inst.affinity, state.output_mem);
+  }, 0, "Broadcast output memory as message event.", {"affinity"});
+
+  // Messages are handled with forking handlers; with a single-member deme, they are delivered back
+  // to the sender.
+  event_fun_t handle_msg = [this](hardware_t & hw, const event_t & event) {
+    ++counts.spawns;
+    hw.SpawnCore(event.affinity, hw.GetMinBindThresh(), event.msg);
+  };
+  AddEvent("SendMessage", handle_msg, "Send message event.");
+  AddEvent("BroadcastMessage", handle_msg, "Broadcast message event.");
+  if (SGP_HW_EVENT_DRIVEN) {
+    event_lib->RegisterDispatchFun("SendMessage", [](hardware_t & hw, const event_t & event) { hw.QueueEvent(event); });
+    event_lib->RegisterDispatchFun("BroadcastMessage", [](hardware_t & hw, const event_t & event) { hw.QueueEvent(event); });
+  } else {
+    AddInst("RetrieveMsg", [](hardware_t & hw, const inst_t & inst) { return; }, 0, "Retrieve a message from message inbox.");
+    event_lib->RegisterDispatchFun("SendMessage", [](hardware_t & hw, const event_t & event) { return; });
+    event_lib->RegisterDispatchFun("BroadcastMessage", [](hardware_t & hw, const event_t & event) { return; });
+  }
+
+  task_inputs.resize(2);
+
+  begin_eval_fun = [this]() {
+    input_load_id = 0;
+    task_inputs[0] = random->GetUInt();
+    task_inputs[1] = random->GetUInt();
+  };
+}
+
+void Benchmark::ConfigSetup__ABResponse() {
+  InstLibBuilder inst_builder(*this);
+  toolbelt::AddStandardInstructions<hardware_t>(inst_builder);
+  AddInst("Call", [](hardware_t & hw, const inst_t & inst) {
+    hw.CallFunction(inst.affinity, hw.GetMinBindThresh(), true);
+  }, 0, "Call function that best matches call affinity.", {"affinity"});
+  AddInst("Fork", [this](hardware_t & hw, const inst_t & inst) {
+    state_t & state = hw.GetCurState();
+    ++counts.spawns;
+    hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem, false, true);
+  }, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.", {"affinity"});
+  AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
+
+  ConfigSetup__Regulation();
+}
+
+/// Promote/Repress (additive reference modifier adjustment) as configured by t_maze and ab_response.
+void Benchmark::ConfigSetup__Regulation() {
+  InstLibBuilder inst_builder(*this);
+  toolbelt::AddRegulationInstructions<hardware_t>(inst_builder, match_cache, REF_MOD_ADJUSTMENT_VALUE, false, MODIFY_REG);
+
+  eval_hw->SetBaseFuncRefMod(0.0);
+  eval_hw->SetFuncRefModifier([](double base_sim, const function_t & function) {
+    return base_sim + function.GetRefModifier();
+  });
+}
+
+/// Generate random programs using the current setup's instruction set.
+void Benchmark::GenerateRandomPrograms(emp::vector<program_t> & programs) {
+  programs.clear();
+  for (size_t i = 0; i < RANDOM_PROGRAM_CNT; ++i) {
+    programs.emplace_back(inst_lib);
+    program_t & prog = programs.back();
+    const size_t fcnt = random->GetUInt(PROG_MIN_FUNC_CNT, PROG_MAX_FUNC_CNT + 1);
+    for (size_t fID = 0; fID < fcnt; ++fID) {
+      function_t new_fun;
+      new_fun.affinity.Randomize(*random);
+      const size_t icnt = random->GetUInt(PROG_MIN_FUNC_LEN, PROG_MAX_FUNC_LEN + 1);
+      for (size_t iID = 0; iID < icnt; ++iID) {
+        new_fun.PushInst(random->GetUInt(inst_lib->GetSize()),
+                         random->GetInt(PROG_MAX_ARG_VAL),
+                         random->GetInt(PROG_MAX_ARG_VAL),
+                         random->GetInt(PROG_MAX_ARG_VAL),
+                         tag_t());
+        new_fun.inst_seq.back().affinity.Randomize(*random);
+      }
+      prog.PushFunction(new_fun);
+    }
+  }
+}
+
+/// Load programs (comma-separated list of files) using the current setup's instruction set.
+void Benchmark::LoadPrograms(const std::string & fpaths, emp::vector<program_t> & programs) {
+  programs.clear();
+  emp::vector<std::string> fpath_list;
+  emp::slice(fpaths, fpath_list, ',');
+  for (const std::string & fpath : fpath_list) {
+    if (fpath.empty()) continue;
+    std::ifstream prog_fstream(fpath);
+    if (!prog_fstream.is_open()) {
+      std::cerr << "Failed to open program file (" << fpath << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+    programs.emplace_back(inst_lib);
+    programs.back().Load(prog_fstream);
+  }
+}
+
+/// Run a single program on evaluation hardware (timed portion: events + SingleProcess calls).
+void Benchmark::EvalProgram(const program_t & program) {
+  eval_hw->SetProgram(program);
+  match_cache.Clear();
+  eval_hw->ResetHardware();
+  for (size_t i = 0; i < TRAIT_CNT; ++i) eval_hw->SetTrait(i, 0);
+  if (program.GetSize() == 0) return;
+
+  auto start = std::chrono::steady_clock::now();
+  ++counts.spawns;
+  eval_hw->SpawnCore(0, memory_t(), true);
+  begin_eval_fun();
+  for (size_t t = 0; t < EVAL_TIME; ++t) {
+    if (t && (t % EVENT_INTERVAL == 0)) env_step_fun(t);
+    eval_hw->SingleProcess();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  counts.single_process_calls += EVAL_TIME;
+  counts.programs += 1;
+  counts.elapsed_sec += std::chrono::duration<double>(end - start).count();
+}
+
+Benchmark::Result Benchmark::RunWorkload(size_t setup_id, const std::string & workload, const emp::vector<program_t> & programs) {
+  counts = Counts();
+  for (size_t rep = 0; rep < REPLICATES; ++rep) {
+    for (const program_t & program : programs) EvalProgram(program);
+  }
+  Result result;
+  result.setup = GetSetupName(setup_id);
+  result.workload = workload;
+  result.inst_set_size = inst_lib->GetSize();
+  result.counts = counts;
+  return result;
+}
+
+/// Configure setup and run its workloads (random, then handcoded if there are any).
+///  - count: is this a counting pass?
+void Benchmark::RunSetup(size_t setup_id, bool count, emp::vector<Result> & setup_results) {
+  count_execs = count;
+  ConfigSetup(setup_id);
+  emp::vector<program_t> programs;
+  GenerateRandomPrograms(programs);
+  setup_results.emplace_back(RunWorkload(setup_id, "random", programs));
+  LoadPrograms(HANDCODED_PROGRAMS[setup_id], programs);
+  if (programs.size()) setup_results.emplace_back(RunWorkload(setup_id, "handcoded", programs));
+}
+
+void Benchmark::Run() {
+  results.clear();
+  for (size_t setup_id : SETUPS) {
+    std::cerr << "Benchmarking " << GetSetupName(setup_id) << std::endl;
+    // ConfigSetup resets the random number generator, so the counting pass generates the same
+    // programs and environment as the timed pass and executes exactly what was timed.
+    emp::vector<Result> timed_results;
+    emp::vector<Result> counted_results;
+    RunSetup(setup_id, false, timed_results);
+    RunSetup(setup_id, true, counted_results);
+    for (size_t i = 0; i < counted_results.size(); ++i) {
+      Result & result = counted_results[i];
+      result.counts.elapsed_sec = timed_results[i].counts.elapsed_sec;
+      results.emplace_back(result);
+      std::cerr << "  " << result.setup << "/" << result.workload << ": " << result.counts.programs << " evaluations, "
+                << result.counts.insts << " instructions in " << result.counts.elapsed_sec << "s" << std::endl;
+    }
+  }
+  CleanupSetup();
+
+  if (OUTPUT_FPATH == "") {
+    PrintResults(std::cout);
+  } else {
+    std::ofstream out_fstream(OUTPUT_FPATH);
+    if (!out_fstream.is_open()) {
+      std::cerr << "Failed to open output file (" << OUTPUT_FPATH << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+    PrintResults(out_fstream);
+  }
+}
+
+void Benchmark::PrintResults(std::ostream & os) const {
+  auto per_sec = [](size_t cnt, double sec) { return (sec > 0.0) ? ((double)cnt / sec) : 0.0; };
+  os << std::setprecision(10);
+  os << "{\n";
+  os << "  \"benchmark\": \"sgp_throughput\",\n";
+  os << "  \"random_seed\": " << RANDOM_SEED << ",\n";
+  os << "  \"eval_time\": " << EVAL_TIME << ",\n";
+  os << "  \"event_interval\": " << EVENT_INTERVAL << ",\n";
+  os << "  \"replicates\": " << REPLICATES << ",\n";
+  os << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result & result = results[i];
+    const Counts & c = result.counts;
+    os << ((i) ? ",\n" : "\n");
+    os << "    {";
+    os << "\"setup\": \"" << result.setup << "\", ";
+    os << "\"workload\": \"" << result.workload << "\", ";
+    os << "\"inst_set_size\": " << result.inst_set_size << ", ";
+    os << "\"evaluations\": " << c.programs << ", ";
+    os << "\"single_process_calls\": " << c.single_process_calls << ", ";
+    os << "\"instructions\": " << c.insts << ", ";
+    os << "\"events\": " << c.events << ", ";
+    os << "\"cores_spawned\": " << c.spawns << ", ";
+    os << "\"elapsed_sec\": " << c.elapsed_sec << ", ";
+    os << "\"instructions_per_sec\": " << per_sec(c.insts, c.elapsed_sec) << ", ";
+    os << "\"events_per_sec\": " << per_sec(c.events, c.elapsed_sec) << ", ";
+    os << "\"cores_spawned_per_sec\": " << per_sec(c.spawns, c.elapsed_sec) << ", ";
+    os << "\"ns_per_single_process\": " << ((c.single_process_calls) ? (1e9 * c.elapsed_sec / c.single_process_calls) : 0.0);
+    os << "}";
+  }
+  os << "\n  ]\n";
+  os << "}" << std::endl;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SGP_THROUGHPUT_CONFIG_H
+#define SGP_THROUGHPUT_CONFIG_H
+
+#include "config/config.h"
+
+EMP_BUILD_CONFIG( SGPThroughputConfig,
+  GROUP(DEFAULT_GROUP, "General Settings"),
+  VALUE(RANDOM_SEED, int, 1, "Random number seed (negative value for based on time)"),
+  VALUE(SETUPS, std::string, "0,1,2,3", "Which hardware setups should we benchmark? (comma-separated)\n0: env_coordination\n1: t_maze\n2: div_of_labor\n3: ab_response"),
+  VALUE(REPLICATES, size_t, 3, "How many times should we run each workload?"),
+  VALUE(OUTPUT_FPATH, std::string, "", "Where should we write JSON results? (empty for stdout)"),
+  GROUP(WORKLOAD_GROUP, "Workload Settings"),
+  VALUE(EVAL_TIME, size_t, 256, "How many SingleProcess calls per program evaluation?"),
+  VALUE(EVENT_INTERVAL, size_t, 8, "Time steps between environment events (for setups that have them)"),
+  VALUE(RANDOM_PROGRAM_CNT, size_t, 200, "How many random programs should we run per setup?"),
+  VALUE(PROG_MIN_FUNC_CNT, size_t, 1, "Minimum number of functions in random programs"),
+  VALUE(PROG_MAX_FUNC_CNT, size_t, 16, "Maximum number of functions in random programs"),
+  VALUE(PROG_MIN_FUNC_LEN, size_t, 1, "Minimum function length in random programs"),
+  VALUE(PROG_MAX_FUNC_LEN, size_t, 32, "Maximum function length in random programs"),
+  VALUE(PROG_MAX_ARG_VAL, int, 16, "Maximum instruction argument value in random programs"),
+  GROUP(HANDCODED_GROUP, "Handcoded Programs (comma-separated program files for each setup)"),
+  VALUE(ENV_COORDINATION_PROGRAMS, std::string, "", "Handcoded env_coordination programs"),
+  VALUE(T_MAZE_PROGRAMS, std::string, "../t_maze/handcoded_solutions/EXS_all-right.gp,../t_maze/handcoded_solutions/EXS_learn-1.gp,../t_maze/handcoded_solutions/EXS_learn-N.gp", "Handcoded t_maze programs"),
+  VALUE(DIV_OF_LABOR_PROGRAMS, std::string, "", "Handcoded div_of_labor programs"),
+  VALUE(AB_RESPONSE_PROGRAMS, std::string, "", "Handcoded ab_response programs"),
+  GROUP(HARDWARE_GROUP, "SignalGP Hardware Settings"),
+  VALUE(SGP_HW_MAX_CORES, size_t, 16, "Max number of hardware cores; i.e., max number of simultaneous threads of execution hardware will support."),
+  VALUE(SGP_HW_MAX_CALL_DEPTH, size_t, 128, "Max call depth of hardware unit"),
+  VALUE(SGP_HW_MIN_BIND_THRESH, double, 0.5, "Hardware minimum referencing threshold"),
+  VALUE(SGP_HW_EVENT_DRIVEN, bool, true, "Are environment signals/messages event-driven? (otherwise, imperative variants are used)"),
+  VALUE(ENVIRONMENT_STATES, size_t, 8, "env_coordination: Total possible number of environment states"),
+  VALUE(REF_MOD_ADJUSTMENT_VALUE, double, 0.1, "t_maze/ab_response: How much do Promote/Repress adjust function reference modifiers? (additive)"),
+  VALUE(MODIFY_REG, bool, true, "t_maze/ab_response: Do Promote/Repress use function regulation when finding their targets?")
+)
+
+#endif
@@ -11,6 +11,10 @@
 #include <functional>
 #include <deque>
 #include <unordered_set>
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <thread>
 
 #include "base/Ptr.h"
 #include "base/vector.h"
@@ -27,6 +31,11 @@
 #include "tools/math.h"
 #include "tools/string_utils.h"
 
+#include "../../utility_belt/source/utilities.h"
+#include "../../utility_belt/source/InstructionSets.h"
+#include "../../utility_belt/source/TaskInputPool.h"
+#include "../../utility_belt/source/PopulationSnapshot.h"
+
 #include "dol-config.h"
 #include "SGPDeme.h"
 #include "TaskSet.h"
@@ -34,6 +43,10 @@
 constexpr size_t RUN_ID__EXP = 0;
 constexpr size_t RUN_ID__ANALYSIS = 1;
 
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__TEXT = 0;
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__BINARY = 1;
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__BOTH = 2;
+
 constexpr size_t TAG_WIDTH = 16;
 
 constexpr uint32_t MIN_TASK_INPUT = 1;
@@ -48,6 +61,7 @@ constexpr size_t TRAIT_ID__DEME_ID = 2;
 constexpr size_t TRAIT_ID__UID = 3;
 constexpr size_t TRAIT_ID__DIR = 4;
 constexpr size_t TRAIT_ID__ROLE_ID = 5;
+constexpr size_t TRAIT_ID__POOL_ID = 6;
 
 constexpr int NO_TASK = -1;
 
@@ -59,6 +73,7 @@ public:
   // Hardware/agent aliases.
   using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
   using program_t = hardware_t::Program;
+  using program_pool_t = toolbelt::ObjectPool<program_t>;
   using state_t = hardware_t::State;
   using inst_t = hardware_t::inst_t;
   using inst_lib_t = hardware_t::inst_lib_t;
@@ -72,20 +87,25 @@ public:
   using world_t = emp::World<Agent>;
   // Task aliases
   using task_io_t = uint32_t;
+  using taskset_t = TaskSet<std::array<task_io_t,MAX_TASK_NUM_INPUTS>,task_io_t>;
+  // Messaging aliases
+  using inbox_t = std::deque<event_t>;
 
   /// Agent to be evolved.
   struct Agent {
     size_t agent_id;
-    program_t program;
+    toolbelt::Pooled<program_t> program;   ///< Recycled through the experiment's program pool.
 
-    Agent(const program_t & _p) : agent_id(0), program(_p) { ; }
-    Agent(const Agent && in) : agent_id(in.GetID()), program(in.program) { ; }
-    Agent(const Agent & in): agent_id(in.GetID()), program(in.program) { ; }
+    Agent(const program_t & _p, emp::Ptr<program_pool_t> pool=nullptr) : agent_id(0), program(_p, pool) { ; }
+    Agent(const Agent & in) = default;
+    Agent(Agent && in) noexcept = default;
+    Agent & operator=(const Agent & in) = default;
+    Agent & operator=(Agent && in) noexcept = default;
 
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
 
-    program_t & GetGenome() { return program; }
+    program_t & GetGenome() { return program.Get(); }
 
   };
 
@@ -99,15 +119,26 @@ public:
     emp::Signal<void(hardware_t &)> on_propagule_activate_sig; // Triggered when a propagule is activated.
     
     size_t phen_id;
+    size_t pool_id;               ///< Position of this deme in the experiment's pool of evaluation demes.
+
+    emp::vector<inbox_t> inboxes; ///< Message inboxes (one per hardware unit; only used by imperative hardware).
+    size_t inbox_capacity;
+
+    taskset_t task_set;           ///< Deme-local copy of experiment's task set.
+    std::array<task_io_t, MAX_TASK_NUM_INPUTS> task_inputs; ///< Current task inputs.
+    size_t input_load_id;
 
   public:
-    DOLDeme(size_t _w, size_t _h, emp::Ptr<emp::Random> _rnd, emp::Ptr<inst_lib_t> _ilib, emp::Ptr<event_lib_t> _elib)
-    : SGPDeme(_w, _h, _rnd, _ilib, _elib), phen_id(0)
+    DOLDeme(size_t _w, size_t _h, emp::Ptr<emp::Random> _rnd, emp::Ptr<inst_lib_t> _ilib, emp::Ptr<event_lib_t> _elib, size_t _pool_id=0)
+    : SGPDeme(_w, _h, _rnd, _ilib, _elib), phen_id(0), pool_id(_pool_id),
+      inboxes(_w*_h), inbox_capacity(0), task_set(), input_load_id(0)
     {
       for (size_t i = 0; i < grid.size(); ++i) {
         grid[i].SetTrait(TRAIT_ID__ACTIVE, 0);
         grid[i].SetTrait(TRAIT_ID__DEME_ID, i);
+        grid[i].SetTrait(TRAIT_ID__POOL_ID, pool_id);
       }
+      for (size_t i = 0; i < MAX_TASK_NUM_INPUTS; ++i) task_inputs[i] = 0;
     }
 
     emp::SignalKey OnPropaguleActivation(const std::function<void(hardware_t &)> & fun) { return on_propagule_activate_sig.AddAction(fun); }
@@ -122,6 +153,70 @@ public:
     size_t GetPhenID() const { return phen_id; }
     void SetPhenID(size_t id) { phen_id = id; }
 
+    size_t GetPoolID() const { return pool_id; }
+
+    // -- Tasks --
+    taskset_t & GetTaskSet() { return task_set; }
+    void SetTaskSet(const taskset_t & _task_set) { task_set = _task_set; }
+
+    /// Set task inputs (and update task solutions to match).
+    void SetTaskInputs(const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
+      task_inputs = inputs;
+      task_set.SetInputs(task_inputs);
+    }
+
+    /// Set task inputs along with their (precomputed) task solutions.
+    void SetTaskInputs(const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs,
+                       const task_io_t * solutions, const emp::vector<size_t> & sol_offsets) {
+      task_inputs = inputs;
+      task_set.SetSolutions(solutions, sol_offsets);
+    }
+    task_io_t GetTaskInput(size_t i) const { return task_inputs[i]; }
+
+    /// Get next task input (cycling through inputs).
+    task_io_t NextTaskInput() {
+      const task_io_t input = task_inputs[input_load_id];
+      input_load_id += 1;
+      if (input_load_id >= task_inputs.size()) input_load_id = 0; // Update load ID.
+      return input;
+    }
+    void ResetInputLoadID() { input_load_id = 0; }
+
+    // -- Inboxes --
+    void SetInboxCapacity(size_t cap) { inbox_capacity = cap; }
+
+    void ResetInboxes() {
+      for (size_t i = 0; i < inboxes.size(); ++i) inboxes[i].clear();
+    }
+
+    void ResetInbox(size_t id) {
+      emp_assert(id < inboxes.size());
+      inboxes[id].clear();
+    }
+
+    inbox_t & GetInbox(size_t id) {
+      emp_assert(id < inboxes.size());
+      return inboxes[id];
+    }
+
+    bool InboxFull(size_t id) const { 
+      emp_assert(id < inboxes.size());
+      return inboxes[id].size() >= inbox_capacity; 
+    }
+
+    bool InboxEmpty(size_t id) const {
+      emp_assert(id < inboxes.size());
+      return inboxes[id].empty();
+    }
+
+    // Deliver message (event) to specified inbox. 
+    // Make room by clearing out old messages (back of deque). 
+    void DeliverToInbox(size_t id, const event_t & event) {
+      emp_assert(id < inboxes.size());
+      while (InboxFull(id)) inboxes[id].pop_back();
+      inboxes[id].emplace_front(event);
+    }
+
     void ActivateDemePropagule(size_t prop_size=1, bool clumpy=false) {
       emp_assert(prop_size <= grid.size());
       if (clumpy) {
@@ -273,9 +368,12 @@ protected:
   size_t GENERATIONS;
   size_t EVAL_TIME;
   size_t TRIAL_CNT;
+  size_t EVAL_THREAD_CNT;
+  bool EVAL_GENOTYPE_CACHE;
   std::string ANCESTOR_FPATH;
   double TASK_BASE_REWARD;
   double TASK_SWITCHING_PENALTY;
+  size_t TASK_INPUT_POOL_SIZE;
   size_t INDIV_TASK_CAP;
   size_t DEME_WIDTH;
   size_t DEME_HEIGHT;
@@ -308,27 +406,27 @@ protected:
   size_t SYSTEMATICS_INTERVAL;
   size_t FITNESS_INTERVAL;
   size_t POP_SNAPSHOT_INTERVAL;
+  size_t POP_SNAPSHOT_FORMAT;
   std::string DATA_DIRECTORY;
 
   size_t DEME_SIZE;
 
   emp::Ptr<emp::Random> random;
   emp::Ptr<world_t> world;
+  program_pool_t program_pool;
 
   emp::Ptr<inst_lib_t> inst_lib;
   emp::Ptr<event_lib_t> event_lib;
-  emp::Ptr<DOLDeme> eval_deme;
-  
-  using inbox_t = std::deque<event_t>;
-  emp::vector<inbox_t> inboxes;
+  emp::vector<emp::Ptr<DOLDeme>> eval_demes;     ///< Pool of evaluation demes (one per evaluation thread).
+  emp::vector<emp::Ptr<emp::Random>> eval_rngs;  ///< Random number generators for each evaluation deme.
+  toolbelt::RandomStreams eval_streams;          ///< Per-(generation, genotype) random number streams for evaluation.
 
-  using taskset_t = TaskSet<std::array<task_io_t,MAX_TASK_NUM_INPUTS>,task_io_t>;
   taskset_t task_set;
-  std::array<task_io_t, MAX_TASK_NUM_INPUTS> task_inputs; ///< Current task inputs.
-  size_t input_load_id;
+  std::array<task_io_t, MAX_TASK_NUM_INPUTS> task_inputs; ///< Current task inputs (shared by all demes within a generation).
+  toolbelt::TaskInputPool<taskset_t> task_input_pool;     ///< Precomputed collision-free task inputs (if TASK_INPUT_POOL_SIZE > 0)
+  size_t task_input_pool_id;                              ///< Pool entry of current task inputs.
 
   size_t update;
-  size_t eval_time;
 
   size_t dom_agent_id;
   tag_t propagule_start_tag;
@@ -345,53 +443,28 @@ protected:
   // Systematics signals.
   emp::Signal<void(size_t)> do_pop_snapshot_sig;    ///< Triggered if we should take a snapshot of the population (as defined by POP_SNAPSHOT_INTERVAL). Should call appropriate functions to take snapshot.
   // Agent signals.
-  emp::Signal<void(Agent &)> begin_agent_eval_sig;
+  // NOTE: Agent/activation signals may be triggered concurrently by different evaluation demes.
+  emp::Signal<void(DOLDeme &, Agent &)> begin_agent_eval_sig;
   // emp::Signal<void(Agent &)> record_cur_phenotype_sig;
-  emp::Signal<void(size_t, const tag_t &, const memory_t &)> on_activate_sig; 
-
-  void ResetInboxes() {
-    for (size_t i = 0; i < inboxes.size(); ++i) inboxes[i].clear();
-  }
-
-  void ResetInbox(size_t id) {
-    emp_assert(id < inboxes.size());
-    inboxes[id].clear();
-  }
-
-  inbox_t & GetInbox(size_t id) {
-    emp_assert(id < inboxes.size());
-    return inboxes[id];
-  }
-
-  bool InboxFull(size_t id) const { 
-    emp_assert(id < inboxes.size());
-    return inboxes[id].size() >= INBOX_CAPACITY; 
-  }
+  emp::Signal<void(DOLDeme &, size_t, const tag_t &, const memory_t &)> on_activate_sig; 
 
-  bool InboxEmpty(size_t id) const {
-    emp_assert(id < inboxes.size());
-    return inboxes[id].empty();
+  /// Get the evaluation deme that the given hardware belongs to.
+  DOLDeme & GetDeme(hardware_t & hw) {
+    return *eval_demes[(size_t)hw.GetTrait(TRAIT_ID__POOL_ID)];
   }
 
-  // Deliver message (event) to specified inbox. 
-  // Make room by clearing out old messages (back of deque). 
-  void DeliverToInbox(size_t id, const event_t & event) {
-    emp_assert(id < inboxes.size());
-    while (InboxFull(id)) inboxes[id].pop_back();
-    inboxes[id].emplace_front(event);
-  }
   
   size_t GetCacheIndex(size_t agent_id, size_t trial_id) {
     return (agent_id * TRIAL_CNT) + trial_id;
   }
 
-  void SubmitTask(size_t hw_id, size_t task_id) {
+  void SubmitTask(DOLDeme & deme, size_t hw_id, size_t task_id) {
     // Submit and record task (TASK_ID) completion for HW_ID.
     // reward = (BASE * SWITCH_PENALTY)*(1/(2**DEME_TASK_N))
-    Phenotype & phen = agent_phen_cache[eval_deme->GetPhenID()];
+    Phenotype & phen = agent_phen_cache[deme.GetPhenID()];
     const size_t prev_task_cnt = phen.GetIndivTotalTaskCnt(hw_id);
     if (prev_task_cnt < INDIV_TASK_CAP) {
-      const int last_task_id = eval_deme->GetLastTask(hw_id);
+      const int last_task_id = deme.GetLastTask(hw_id);
       const bool task_switch = !(task_id == last_task_id || last_task_id == NO_TASK);
       const double switch_penalty = (task_switch) ? TASK_SWITCHING_PENALTY : 1;
       const double deme_task_cnt = phen.GetDemeTaskCnt(task_id);
@@ -406,12 +479,18 @@ protected:
       phen.task_total++;
       phen.score += reward;
 
-      eval_deme->SetLastTask(hw_id, task_id);
+      deme.SetLastTask(hw_id, task_id);
     }
   }
 
   /// Guarantee no solution collisions!
   void ResetTasks() {
+    if (task_input_pool.GetSize()) {
+      task_input_pool_id = random->GetUInt(task_input_pool.GetSize());
+      task_inputs = task_input_pool.GetInputs(task_input_pool_id);
+      task_input_pool.Load(task_input_pool_id, task_set);
+      return;
+    }
     task_inputs[0] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
     task_inputs[1] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
     task_set.SetInputs(task_inputs);
@@ -422,15 +501,29 @@ protected:
     }
   }
 
-  void Evaluate(Agent & agent) {
-    begin_agent_eval_sig.Trigger(agent);
-    for (eval_time = 0; eval_time < EVAL_TIME; ++eval_time) {
-      eval_deme->SingleAdvance();
+  /// Give deme the current task inputs (using precomputed solutions if inputs came from the pool).
+  void LoadTasks(DOLDeme & deme) {
+    if (task_input_pool.GetSize()) {
+      deme.SetTaskInputs(task_inputs, task_input_pool.GetSolutions(task_input_pool_id),
+                         task_input_pool.GetSolutionOffsets());
+    } else {
+      deme.SetTaskInputs(task_inputs);
+    }
+  }
+
+  void Evaluate(DOLDeme & deme, Agent & agent) {
+    begin_agent_eval_sig.Trigger(deme, agent);
+    for (size_t eval_time = 0; eval_time < EVAL_TIME; ++eval_time) {
+      deme.SingleAdvance();
     }
     // Record everything we want to store about trial phenotype:
     // record_cur_phenotype_sig.Trigger(agent); // TODO: might not need this!
   }
 
+  /// Evaluate entire population, distributing agents over the pool of evaluation demes.
+  /// If EVAL_GENOTYPE_CACHE, only the first copy of each unique genotype is evaluated.
+  void EvaluatePopulation();
+
   /// Test function.
   /// Exists to test features as I add them.
   void Test() {
@@ -443,30 +536,32 @@ protected:
     agent.GetGenome().PrintProgramFull();
     std::cout << "----------------------" << std::endl;
 
+    DOLDeme & eval_deme = *eval_demes[0];
     agent.SetID(0);
-    eval_deme->SetProgram(agent.GetGenome());
-    eval_deme->SetPhenID(0);
+    eval_deme.SetProgram(agent.GetGenome());
+    eval_deme.SetPhenID(0);
     agent_phen_cache[0].Reset();
     ResetTasks();
+    LoadTasks(eval_deme);
     std::cout << "Before begin-agent-eval signal!" << std::endl;
-    eval_deme->PrintState();
-    begin_agent_eval_sig.Trigger(agent);
+    eval_deme.PrintState();
+    begin_agent_eval_sig.Trigger(eval_deme, agent);
     std::cout << "Post begin-agent-eval signal!" << std::endl;
-    eval_deme->PrintActive();
-    eval_deme->PrintState();
+    eval_deme.PrintActive();
+    eval_deme.PrintState();
     std::cout << "------ RUNNING! ------" << std::endl;
     Phenotype & phen = agent_phen_cache[0];
-    for (eval_time = 0; eval_time < EVAL_TIME; ++eval_time) {
-      eval_deme->SingleAdvance();
+    for (size_t eval_time = 0; eval_time < EVAL_TIME; ++eval_time) {
+      eval_deme.SingleAdvance();
       
       std::cout << "=========================== TIME: " << eval_time << " ===========================" << std::endl;
       
-      eval_deme->PrintActive();
+      eval_deme.PrintActive();
       
       // Print inbox sizes
       std::cout << "Inbox cnts: [";
-      for (size_t i = 0; i < inboxes.size(); ++i) {
-        std::cout << " " << i << ":" << inboxes[i].size();
+      for (size_t i = 0; i < eval_deme.GetSize(); ++i) {
+        std::cout << " " << i << ":" << eval_deme.GetInbox(i).size();
       } std::cout << "]" << std::endl;
       
       // Print Phenotype info
@@ -479,7 +574,7 @@ protected:
         std::cout << " " << task_set.GetName(i) << ":" << phen.GetDemeTaskCnt(i);
       } std::cout << "]" << std::endl;
       std::cout << "Individual informations: " << std::endl;
-      for (size_t hwID = 0; hwID < eval_deme->GetSize(); ++hwID) {
+      for (size_t hwID = 0; hwID < eval_deme.GetSize(); ++hwID) {
         std::cout << " -- " << hwID << " -- " << std::endl;
         std::cout << "  Total tasks: " << phen.GetIndivTotalTaskCnt(hwID) << std::endl;
         std::cout << "  Task switches: " << phen.GetIndivTaskSwitches(hwID) << std::endl;
@@ -488,7 +583,7 @@ protected:
           std::cout << " " << task_set.GetName(i) << ":" << phen.GetIndivTaskCnt(hwID, i);
         } std::cout << "]" << std::endl;
       }
-      eval_deme->PrintState();
+      eval_deme.PrintState();
     }
     std::cout << "DONE EVALUATING DEME" << std::endl;
 
@@ -503,7 +598,7 @@ protected:
       std::cout << " " << task_set.GetName(i) << ":" << phen.GetDemeTaskCnt(i);
     } std::cout << "]" << std::endl;
     std::cout << "Individual informations: " << std::endl;
-    for (size_t hwID = 0; hwID < eval_deme->GetSize(); ++hwID) {
+    for (size_t hwID = 0; hwID < eval_deme.GetSize(); ++hwID) {
       std::cout << " -- " << hwID << " -- " << std::endl;
       std::cout << "  Total tasks: " << phen.GetIndivTotalTaskCnt(hwID) << std::endl;
       std::cout << "  Task switches: " << phen.GetIndivTaskSwitches(hwID) << std::endl;
@@ -552,9 +647,8 @@ protected:
 
 public:
   Experiment(const DOLConfig & config)
-    : DEME_SIZE(0), inboxes(0),
-      input_load_id(0), update(0),
-      eval_time(0), dom_agent_id(0), propagule_start_tag()
+    : DEME_SIZE(0), task_input_pool_id(0), update(0),
+      dom_agent_id(0), propagule_start_tag()
   {
     RUN_MODE = config.RUN_MODE();
     RANDOM_SEED = config.RANDOM_SEED();
@@ -562,8 +656,11 @@ public:
     GENERATIONS = config.GENERATIONS();
     EVAL_TIME = config.EVAL_TIME();
     TRIAL_CNT = config.TRIAL_CNT();
+    EVAL_THREAD_CNT = config.EVAL_THREAD_CNT();
+    EVAL_GENOTYPE_CACHE = config.EVAL_GENOTYPE_CACHE();
     TASK_BASE_REWARD = config.TASK_BASE_REWARD();
     TASK_SWITCHING_PENALTY = config.TASK_SWITCHING_PENALTY();
+    TASK_INPUT_POOL_SIZE = config.TASK_INPUT_POOL_SIZE();
     INDIV_TASK_CAP = config.INDIV_TASK_CAP();
     DEME_WIDTH = config.DEME_WIDTH();
     DEME_HEIGHT = config.DEME_HEIGHT();
@@ -597,12 +694,20 @@ public:
     SYSTEMATICS_INTERVAL = config.SYSTEMATICS_INTERVAL();
     FITNESS_INTERVAL = config.FITNESS_INTERVAL();
     POP_SNAPSHOT_INTERVAL = config.POP_SNAPSHOT_INTERVAL();
+    POP_SNAPSHOT_FORMAT = config.POP_SNAPSHOT_FORMAT();
     DATA_DIRECTORY = config.DATA_DIRECTORY();
 
     DEME_SIZE = DEME_WIDTH*DEME_HEIGHT;
 
+    if (EVAL_THREAD_CNT < 1) {
+      std::cout << "Cannot run experiment with EVAL_THREAD_CNT < 1. Exiting..." << std::endl;
+      exit(-1);
+    }
+
     // Make the random number generator.
     random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+    // Evaluation random number streams are derived from the experiment's random seed.
+    eval_streams.SetBaseSeed(random->GetUInt());
 
     // Make the world!
     world = emp::NewPtr<world_t>(random, "World");
@@ -662,6 +767,11 @@ public:
     }
   }
 
+  ~Experiment() {
+    for (size_t i = 0; i < eval_demes.size(); ++i) eval_demes[i].Delete();
+    for (size_t i = 0; i < eval_rngs.size(); ++i) eval_rngs[i].Delete();
+  }
+
   void RunStep() {
     do_evaluation_sig.Trigger();
     do_selection_sig.Trigger();
@@ -684,9 +794,7 @@ public:
   // Instructions
   // (execution control)
   static void Inst_Fork(hardware_t & hw, const inst_t & inst);
-  static void Inst_Terminate(hardware_t & hw, const inst_t & inst);
   // (logic tasks)
-  static void Inst_Nand(hardware_t & hw, const inst_t & inst);
   void Inst_Load1(hardware_t & hw, const inst_t & inst);
   void Inst_Load2(hardware_t & hw, const inst_t & inst);
   void Inst_Submit(hardware_t & hw, const inst_t & inst);
@@ -724,33 +832,21 @@ void Experiment::Inst_Fork(hardware_t & hw, const inst_t & inst) {
   hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem);
 }
 
-void Experiment::Inst_Nand(hardware_t & hw, const inst_t & inst) {
-  state_t & state = hw.GetCurState();
-  const task_io_t a = (task_io_t)state.GetLocal(inst.args[0]);
-  const task_io_t b = (task_io_t)state.GetLocal(inst.args[1]);
-  state.SetLocal(inst.args[2], ~(a&b));
-}
-
-void Experiment::Inst_Terminate(hardware_t & hw, const inst_t & inst) {
-  // Pop all the call states from current core.
-  exec_stk_t & core = hw.GetCurCore();
-  core.resize(0);
-}
-
 void Experiment::Inst_Load1(hardware_t & hw, const inst_t & inst) {
   state_t & state = hw.GetCurState();
-  state.SetLocal(inst.args[0], task_inputs[input_load_id]); // Load input.
-  input_load_id += 1;
-  if (input_load_id >= task_inputs.size()) input_load_id = 0; // Update load ID.
+  state.SetLocal(inst.args[0], GetDeme(hw).NextTaskInput()); // Load input.
 }
 
 void Experiment::Inst_Load2(hardware_t & hw, const inst_t & inst) {
+  DOLDeme & deme = GetDeme(hw);
   state_t & state = hw.GetCurState();
-  state.SetLocal(inst.args[0], task_inputs[0]);
-  state.SetLocal(inst.args[1], task_inputs[1]);
+  state.SetLocal(inst.args[0], deme.GetTaskInput(0));
+  state.SetLocal(inst.args[1], deme.GetTaskInput(1));
 }
 
 void Experiment::Inst_Submit(hardware_t & hw, const inst_t & inst) {
+  DOLDeme & deme = GetDeme(hw);
+  taskset_t & task_set = deme.GetTaskSet();
   state_t & state = hw.GetCurState();
   // Submit! --> Did hw complete a task?
   task_io_t sol = (task_io_t)state.GetLocal(inst.args[0]);
@@ -758,18 +854,19 @@ void Experiment::Inst_Submit(hardware_t & hw, const inst_t & inst) {
   // NOTE: Task solutions are guaranteed to be unique to each task.
   for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
     if (task_set.CheckTask(task_id, sol)) {
-      SubmitTask(hw_id, task_id);
+      SubmitTask(deme, hw_id, task_id);
       break;
     }
   }
 }
 
 void Experiment::Inst_ActivateFacing(hardware_t & hw, const inst_t & inst) {
+  DOLDeme & deme = GetDeme(hw);
   state_t & state = hw.GetCurState();
   const size_t loc_id = (size_t)hw.GetTrait(TRAIT_ID__DEME_ID);
   const size_t dir = (size_t)hw.GetTrait(TRAIT_ID__DIR);
-  const size_t facing_id = eval_deme->GetNeighborID(loc_id, dir);
-  on_activate_sig.Trigger(facing_id, inst.affinity, state.output_mem);
+  const size_t facing_id = deme.GetNeighborID(loc_id, dir);
+  on_activate_sig.Trigger(deme, facing_id, inst.affinity, state.output_mem);
 }
 
 void Experiment::Inst_RotCW(hardware_t & hw, const inst_t & inst) {
@@ -796,11 +893,10 @@ void Experiment::Inst_BroadcastMsg(hardware_t & hw, const inst_t & inst) {
 }
 
 void Experiment::Inst_RetrieveMsg(hardware_t & hw, const inst_t & inst) {
+  DOLDeme & deme = GetDeme(hw);
   const size_t loc_id = (size_t)hw.GetTrait(TRAIT_ID__DEME_ID);
-  std::cout << "Inst: RetrieveMsg!" << std::endl;
-  if (!InboxEmpty(loc_id)) {
-    std::cout << "Inbox is not empty!" << std::endl;
-    inbox_t & inbox = GetInbox(loc_id);
+  if (!deme.InboxEmpty(loc_id)) {
+    inbox_t & inbox = deme.GetInbox(loc_id);
     hw.HandleEvent(inbox.front());
     inbox.pop_front(); // Remove!
   }
@@ -817,46 +913,51 @@ void Experiment::Inst_SetRoleID(hardware_t & hw, const inst_t & inst) {
 }
 
 void Experiment::Inst_GetLocXY(hardware_t & hw, const inst_t & inst) {
+  DOLDeme & deme = GetDeme(hw);
   state_t & state = hw.GetCurState();
-  const size_t x = eval_deme->GetLocX((size_t)hw.GetTrait(TRAIT_ID__DEME_ID));
-  const size_t y = eval_deme->GetLocY((size_t)hw.GetTrait(TRAIT_ID__DEME_ID));
+  const size_t x = deme.GetLocX((size_t)hw.GetTrait(TRAIT_ID__DEME_ID));
+  const size_t y = deme.GetLocY((size_t)hw.GetTrait(TRAIT_ID__DEME_ID));
   state.SetLocal(inst.args[0], x);
   state.SetLocal(inst.args[1], y);
 }
 
 void Experiment::EventDriven__DispatchMessage_Send(hardware_t & hw, const event_t & event) {
-  const size_t facing_id = eval_deme->GetNeighborID((size_t)hw.GetTrait(TRAIT_ID__DEME_ID), (size_t)hw.GetTrait(TRAIT_ID__DIR));
-  hardware_t & rHW = eval_deme->GetHardware(facing_id);
-  if (eval_deme->IsActive(facing_id)) rHW.QueueEvent(event);
+  DOLDeme & deme = GetDeme(hw);
+  const size_t facing_id = deme.GetNeighborID((size_t)hw.GetTrait(TRAIT_ID__DEME_ID), (size_t)hw.GetTrait(TRAIT_ID__DIR));
+  hardware_t & rHW = deme.GetHardware(facing_id);
+  if (deme.IsActive(facing_id)) rHW.QueueEvent(event);
 }
 
 void Experiment::EventDriven__DispatchMessage_Broadcast(hardware_t & hw, const event_t & event) {
+  DOLDeme & deme = GetDeme(hw);
   const size_t loc_id = (size_t)hw.GetTrait(TRAIT_ID__DEME_ID);
-  const size_t uid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_UP);
-  const size_t did = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_DOWN);
-  const size_t lid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_LEFT);
-  const size_t rid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_RIGHT);
-  if (eval_deme->IsActive(uid)) eval_deme->GetHardware(uid).QueueEvent(event);  
-  if (eval_deme->IsActive(did)) eval_deme->GetHardware(did).QueueEvent(event);
-  if (eval_deme->IsActive(lid)) eval_deme->GetHardware(lid).QueueEvent(event);
-  if (eval_deme->IsActive(rid)) eval_deme->GetHardware(rid).QueueEvent(event);  
+  const size_t uid = deme.GetNeighborID(loc_id, DOLDeme::DIR_UP);
+  const size_t did = deme.GetNeighborID(loc_id, DOLDeme::DIR_DOWN);
+  const size_t lid = deme.GetNeighborID(loc_id, DOLDeme::DIR_LEFT);
+  const size_t rid = deme.GetNeighborID(loc_id, DOLDeme::DIR_RIGHT);
+  if (deme.IsActive(uid)) deme.GetHardware(uid).QueueEvent(event);  
+  if (deme.IsActive(did)) deme.GetHardware(did).QueueEvent(event);
+  if (deme.IsActive(lid)) deme.GetHardware(lid).QueueEvent(event);
+  if (deme.IsActive(rid)) deme.GetHardware(rid).QueueEvent(event);  
 }
 
 void Experiment::Imperative__DispatchMessage_Send(hardware_t & hw, const event_t & event) {
-  const size_t facing_id = eval_deme->GetNeighborID(hw.GetTrait(TRAIT_ID__DEME_ID), hw.GetTrait(TRAIT_ID__DIR));
-  if (eval_deme->IsActive(facing_id)) DeliverToInbox(facing_id, event);
+  DOLDeme & deme = GetDeme(hw);
+  const size_t facing_id = deme.GetNeighborID(hw.GetTrait(TRAIT_ID__DEME_ID), hw.GetTrait(TRAIT_ID__DIR));
+  if (deme.IsActive(facing_id)) deme.DeliverToInbox(facing_id, event);
 }
 
 void Experiment::Imperative__DispatchMessage_Broadcast(hardware_t & hw, const event_t & event) {
+  DOLDeme & deme = GetDeme(hw);
   const size_t loc_id = (size_t)hw.GetTrait(TRAIT_ID__DEME_ID);
-  const size_t uid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_UP);
-  const size_t did = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_DOWN);
-  const size_t lid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_LEFT);
-  const size_t rid = eval_deme->GetNeighborID(loc_id, DOLDeme::DIR_RIGHT);
-  if (eval_deme->IsActive(uid)) DeliverToInbox(uid, event);
-  if (eval_deme->IsActive(did)) DeliverToInbox(did, event);
-  if (eval_deme->IsActive(lid)) DeliverToInbox(lid, event);
-  if (eval_deme->IsActive(rid)) DeliverToInbox(rid, event);
+  const size_t uid = deme.GetNeighborID(loc_id, DOLDeme::DIR_UP);
+  const size_t did = deme.GetNeighborID(loc_id, DOLDeme::DIR_DOWN);
+  const size_t lid = deme.GetNeighborID(loc_id, DOLDeme::DIR_LEFT);
+  const size_t rid = deme.GetNeighborID(loc_id, DOLDeme::DIR_RIGHT);
+  if (deme.IsActive(uid)) deme.DeliverToInbox(uid, event);
+  if (deme.IsActive(did)) deme.DeliverToInbox(did, event);
+  if (deme.IsActive(lid)) deme.DeliverToInbox(lid, event);
+  if (deme.IsActive(rid)) deme.DeliverToInbox(rid, event);
 }
 
 void Experiment::HandleEvent__Message_Forking(hardware_t & hw, const event_t & event) {
@@ -872,6 +973,51 @@ void Experiment::HandleEvent__Message_NonForking(hardware_t & hw, const event_t
 }
 
 // --- Utilities ---
+void Experiment::EvaluatePopulation() {
+  const size_t pop_size = world->GetSize();
+  // Figure out which agents need to be evaluated (and which are copies of an evaluated genotype).
+  emp::vector<size_t> eval_ids;
+  emp::vector<size_t> genotype_hashes(pop_size);
+  emp::vector<std::pair<size_t, size_t>> copies; // (copy id, evaluated id)
+  toolbelt::GenotypeIndex genotypes;
+  auto same_genotype = [this](size_t a, size_t b) {
+    return toolbelt::SameProgram(world->GetOrg(a).GetGenome(), world->GetOrg(b).GetGenome());
+  };
+  for (size_t id = 0; id < pop_size; ++id) {
+    Agent & our_hero = world->GetOrg(id);
+    our_hero.SetID(id);
+    genotype_hashes[id] = toolbelt::HashProgram(our_hero.GetGenome());
+    if (!EVAL_GENOTYPE_CACHE) { eval_ids.emplace_back(id); continue; }
+    const size_t eval_id = genotypes.FindOrAdd(genotype_hashes[id], id, same_genotype);
+    if (eval_id == id) eval_ids.emplace_back(id);
+    else copies.emplace_back(id, eval_id);
+  }
+  std::atomic<size_t> next_id(0);
+  // Each deme pulls the next unevaluated agent until there are none left.
+  // Each genotype's evaluation draws from its own random number stream, so it does not matter
+  // which deme evaluates an agent or in what order agents are evaluated.
+  auto do_work = [this, &eval_ids, &genotype_hashes, &next_id](size_t pool_id) {
+    DOLDeme & deme = *eval_demes[pool_id];
+    for (size_t i = next_id++; i < eval_ids.size(); i = next_id++) {
+      const size_t id = eval_ids[i];
+      Agent & our_hero = world->GetOrg(id);
+      eval_streams.SeedStream(*eval_rngs[pool_id], update, genotype_hashes[id]);
+      deme.SetProgram(our_hero.GetGenome());
+      deme.SetPhenID(id);
+      deme.ResetInputLoadID();
+      agent_phen_cache[id].Reset();
+      this->Evaluate(deme, our_hero);
+    }
+  };
+  // Deme 0 is run on the calling thread.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < eval_demes.size(); ++i) threads.emplace_back(do_work, i);
+  do_work(0);
+  for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+  // Copies reuse the phenotype of their evaluated genotype.
+  for (size_t i = 0; i < copies.size(); ++i) agent_phen_cache[copies[i].first] = agent_phen_cache[copies[i].second];
+}
+
 void Experiment::InitPopulation_FromAncestorFile() {
   std::cout << "Initializing population from ancestor file!" << std::endl;
   // Configure the ancestor program.
@@ -885,18 +1031,28 @@ void Experiment::InitPopulation_FromAncestorFile() {
   std::cout << " --- Ancestor program: ---" << std::endl;
   ancestor_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
-  world->Inject(ancestor_prog, 1);    // Inject a bunch of ancestors into the population.
+  world->Inject(Agent(ancestor_prog, &program_pool), 1);    // Inject a bunch of ancestors into the population.
 }
 
 void Experiment::Snapshot_SingleFile(size_t update) {
   std::string snapshot_dir = DATA_DIRECTORY + "pop_" + emp::to_string((int)update);
   mkdir(snapshot_dir.c_str(), ACCESSPERMS);
+  const std::string snapshot_fpath = snapshot_dir + "/pop_" + emp::to_string((int)update);
+  // Binary snapshot (.bpop): program IDs are world positions.
+  if (POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BINARY || POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BOTH) {
+    toolbelt::PopulationFileWriter<hardware_t> pop_writer(*inst_lib);
+    for (size_t i = 0; i < world->GetSize(); ++i) pop_writer.Add(world->GetOrg(i).GetGenome(), i);
+    if (!pop_writer.Write(snapshot_fpath + ".bpop")) {
+      std::cout << "Failed to write population snapshot (" << snapshot_fpath << ".bpop)." << std::endl;
+    }
+  }
+  if (POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BINARY) return;
   // For each program in the population, dump the full program description in a single file.
-  std::ofstream prog_ofstream(snapshot_dir + "/pop_" + emp::to_string((int)update) + ".pop");
+  std::ofstream prog_ofstream(snapshot_fpath + ".pop");
   for (size_t i = 0; i < world->GetSize(); ++i) {
     if (i) prog_ofstream << "===\n";
     Agent & agent = world->GetOrg(i);
-    agent.program.PrintProgramFull(prog_ofstream);
+    agent.GetGenome().PrintProgramFull(prog_ofstream);
   }
   prog_ofstream.close();
 }
@@ -979,26 +1135,24 @@ void Experiment::Config_Run() {
     do_pop_init_sig.Trigger();
   });
 
-  begin_agent_eval_sig.AddAction([this](Agent & agent) {
+  begin_agent_eval_sig.AddAction([this](DOLDeme & deme, Agent & agent) {
     // Do agent setup at the beginning of its evaluation.
-    // - Here, the eval_deme has been reset.
+    // - Here, the eval deme has been reset.
     // - No agents in deme have active threads.
     // Setup propagule.
-    eval_deme->ActivateDemePropagule(PROPAGULE_SIZE, PROPAGULE_CLUMPY);
+    deme.ActivateDemePropagule(PROPAGULE_SIZE, PROPAGULE_CLUMPY);
   });
 
   // On evaluation:
   do_evaluation_sig.AddAction([this]() {
     double best_score = -32767;
     dom_agent_id = 0;
+    // All agents see the same task inputs this generation.
     ResetTasks();
+    for (size_t i = 0; i < eval_demes.size(); ++i) LoadTasks(*eval_demes[i]);
+    // Evaluate! (across the pool of evaluation demes)
+    this->EvaluatePopulation();
     for (size_t id = 0; id < world->GetSize(); ++id) {
-      Agent & our_hero = world->GetOrg(id);
-      our_hero.SetID(id);
-      eval_deme->SetProgram(our_hero.GetGenome());
-      eval_deme->SetPhenID(id);
-      agent_phen_cache[id].Reset();
-      this->Evaluate(our_hero);
       if (agent_phen_cache[id].GetScore() > best_score) { best_score = agent_phen_cache[id].GetScore(); dom_agent_id = id; }
     }
     std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
@@ -1024,35 +1178,10 @@ void Experiment::Config_Analysis() { ; }
 void Experiment::Config_HW() {
   // - Setup the instruction set. -
   // Standard instructions:
-  inst_lib->AddInst("Inc", hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
-  inst_lib->AddInst("Dec", hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
-  inst_lib->AddInst("Not", hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
-  inst_lib->AddInst("Add", hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
-  inst_lib->AddInst("Sub", hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
-  inst_lib->AddInst("Mult", hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
-  inst_lib->AddInst("Div", hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
-  inst_lib->AddInst("Mod", hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
-  inst_lib->AddInst("TestEqu", hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
-  inst_lib->AddInst("TestNEqu", hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
-  inst_lib->AddInst("TestLess", hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
-  inst_lib->AddInst("If", hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("While", hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Countdown", hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Close", hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
-  inst_lib->AddInst("Break", hardware_t::Inst_Break, 0, "Break out of current block.");
-  inst_lib->AddInst("Call", hardware_t::Inst_Call, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
-  inst_lib->AddInst("Return", hardware_t::Inst_Return, 0, "Return from current function if possible.");
-  inst_lib->AddInst("SetMem", hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
-  inst_lib->AddInst("CopyMem", hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
-  inst_lib->AddInst("SwapMem", hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
-  inst_lib->AddInst("Input", hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
-  inst_lib->AddInst("Output", hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
-  inst_lib->AddInst("Commit", hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Pull", hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Nop", hardware_t::Inst_Nop, 0, "No operation.");
+  toolbelt::AddStandardInstructions<hardware_t>(*inst_lib, hardware_t::Inst_Call);
   inst_lib->AddInst("Fork", Inst_Fork, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.");
-  inst_lib->AddInst("Nand", Inst_Nand, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
-  inst_lib->AddInst("Terminate", Inst_Terminate, 0, "Kill current thread.");
+  inst_lib->AddInst("Nand", toolbelt::Inst_Nand<hardware_t, task_io_t>, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
+  inst_lib->AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
 
   // Add experiment-specific instructions.
   inst_lib->AddInst("Load-1", [this](hardware_t & hw, const inst_t & inst) { this->Inst_Load1(hw, inst); }, 1, "WM[ARG1] = TaskInput[LOAD_ID]; LOAD_ID++;");
@@ -1074,28 +1203,44 @@ void Experiment::Config_HW() {
   inst_lib->AddInst("BroadcastMsg", Inst_BroadcastMsg, 0, "Broadcast output memory as message event.", emp::ScopeType::BASIC, 0, {"affinity"});
 
   // Configure evaluation hardware.
-  // Make eval deme.
-  eval_deme = emp::NewPtr<DOLDeme>(DEME_WIDTH, DEME_HEIGHT, random, inst_lib, event_lib);
-  eval_deme->SetHardwareMinBindThresh(SGP_HW_MIN_BIND_THRESH);
-  eval_deme->SetHardwareMaxCores(SGP_HW_MAX_CORES);
-  eval_deme->SetHardwareMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
-
-  eval_deme->OnHardwareReset([this](hardware_t & hw) {
-    hw.SetTrait(TRAIT_ID__ACTIVE, 0);
-    hw.SetTrait(TRAIT_ID__LAST_TASK, NO_TASK);
-    hw.SetTrait(TRAIT_ID__UID, 0);
-    hw.SetTrait(TRAIT_ID__DIR, 0);
-    hw.SetTrait(TRAIT_ID__ROLE_ID, 0);
-  });
+  // Make pool of eval demes (each with its own random number generator).
+  // Deme generators are reseeded from eval_streams for every evaluation. Their initial seeds also
+  // come from eval_streams (a reserved key) rather than random, which the world draws from: the
+  // number of demes must not change the world's random draws.
+  for (size_t i = 0; i < EVAL_THREAD_CNT; ++i) {
+    eval_rngs.emplace_back(emp::NewPtr<emp::Random>(eval_streams.GetSeed((size_t)-2, i)));
+    eval_demes.emplace_back(emp::NewPtr<DOLDeme>(DEME_WIDTH, DEME_HEIGHT, eval_rngs.back(), inst_lib, event_lib, i));
+    DOLDeme & eval_deme = *eval_demes.back();
+    eval_deme.SetTaskSet(task_set);
+    eval_deme.SetInboxCapacity(INBOX_CAPACITY);
+    eval_deme.SetHardwareMinBindThresh(SGP_HW_MIN_BIND_THRESH);
+    eval_deme.SetHardwareMaxCores(SGP_HW_MAX_CORES);
+    eval_deme.SetHardwareMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+
+    eval_deme.OnHardwareReset([this](hardware_t & hw) {
+      hw.SetTrait(TRAIT_ID__ACTIVE, 0);
+      hw.SetTrait(TRAIT_ID__LAST_TASK, NO_TASK);
+      hw.SetTrait(TRAIT_ID__UID, 0);
+      hw.SetTrait(TRAIT_ID__DIR, 0);
+      hw.SetTrait(TRAIT_ID__ROLE_ID, 0);
+    });
 
-  eval_deme->OnHardwareAdvance([this](hardware_t & hw) {
-    if ((bool)hw.GetTrait(TRAIT_ID__ACTIVE)) hw.SingleProcess();
-  });
+    eval_deme.OnHardwareAdvance([this](hardware_t & hw) {
+      if ((bool)hw.GetTrait(TRAIT_ID__ACTIVE)) hw.SingleProcess();
+    });
 
-  eval_deme->OnPropaguleActivation([this](hardware_t & hw) {
-    // Trigger on_activate_sig
-    on_activate_sig.Trigger(hw.GetTrait(TRAIT_ID__DEME_ID), propagule_start_tag, memory_t());
-  });
+    eval_deme.OnPropaguleActivation([this](hardware_t & hw) {
+      // Trigger on_activate_sig
+      on_activate_sig.Trigger(GetDeme(hw), hw.GetTrait(TRAIT_ID__DEME_ID), propagule_start_tag, memory_t());
+    });
+
+    if (!SGP_HW_EVENT_DRIVEN) {
+      // Imperative hardware uses inboxes.
+      eval_deme.OnHardwareReset([this](hardware_t & hw) {
+        this->GetDeme(hw).ResetInbox(hw.GetTrait(TRAIT_ID__DEME_ID));
+      });
+    }
+  }
 
   if (SGP_HW_FORK_ON_MSG) {
     event_lib->AddEvent("SendMessage", HandleEvent__Message_Forking, "Send message event.");
@@ -1129,52 +1274,46 @@ void Experiment::Config_HW() {
     event_lib->RegisterDispatchFun("BroadcastMessage", [this](hardware_t &hw, const event_t &event) {
       this->Imperative__DispatchMessage_Broadcast(hw, event);
     });
-   
-    // Configure inboxes.
-    inboxes.resize(DEME_SIZE);
-    eval_deme->OnHardwareReset([this](hardware_t & hw) {
-      this->ResetInbox(hw.GetTrait(TRAIT_ID__DEME_ID));
-    });
   }
 
   // What happens on activate signal?
   if (TAG_BASED_ACTIVATION && ANY_TIME_ACTIVATION) {
     // Tag-based, anytime activation.
-    on_activate_sig.AddAction([this](size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
+    on_activate_sig.AddAction([this](DOLDeme & eval_deme, size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
       // Tell eval deme that this agent is active. 
-      eval_deme->Activate(activate_id);
+      eval_deme.Activate(activate_id);
       // Give agent something to do... 
-      hardware_t & hw = eval_deme->GetHardware(activate_id);
+      hardware_t & hw = eval_deme.GetHardware(activate_id);
       hw.SpawnCore(activate_tag, 0.0, in_mem, false);
     });
   } else if (TAG_BASED_ACTIVATION && !ANY_TIME_ACTIVATION) {
     // Tag-based, 1-time activation.
-    on_activate_sig.AddAction([this](size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
-      if (!eval_deme->IsActive(activate_id)) {
+    on_activate_sig.AddAction([this](DOLDeme & eval_deme, size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
+      if (!eval_deme.IsActive(activate_id)) {
         // Tell eval deme that this agent is active. 
-        eval_deme->Activate(activate_id);
+        eval_deme.Activate(activate_id);
         // Give agent something to do... 
-        hardware_t & hw = eval_deme->GetHardware(activate_id);
+        hardware_t & hw = eval_deme.GetHardware(activate_id);
         hw.SpawnCore(activate_tag, 0.0, in_mem, false);
       }
     });
   } else if (!TAG_BASED_ACTIVATION && ANY_TIME_ACTIVATION) {
     // Not tag-based, any-time activation.
-    on_activate_sig.AddAction([this](size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
+    on_activate_sig.AddAction([this](DOLDeme & eval_deme, size_t activate_id, const tag_t & activate_tag, const memory_t & in_mem) {
       // Tell eval deme that this agent is active. 
-      eval_deme->Activate(activate_id);
+      eval_deme.Activate(activate_id);
       // Give agent something to do... 
-      hardware_t & hw = eval_deme->GetHardware(activate_id);
+      hardware_t & hw = eval_deme.GetHardware(activate_id);
       hw.SpawnCore(0, in_mem, false);
     });
   } else if (!TAG_BASED_ACTIVATION && !ANY_TIME_ACTIVATION) {
     // Not tag-based, 1-time activation.
-    on_activate_sig.AddAction([this](size_t activate_id, const tag_t &activate_tag, const memory_t &in_mem) {
-      if (!eval_deme->IsActive(activate_id)) {      
+    on_activate_sig.AddAction([this](DOLDeme & eval_deme, size_t activate_id, const tag_t &activate_tag, const memory_t &in_mem) {
+      if (!eval_deme.IsActive(activate_id)) {      
         // Tell eval deme that this agent is active.
-        eval_deme->Activate(activate_id);
+        eval_deme.Activate(activate_id);
         // Give agent something to do...
-        hardware_t &hw = eval_deme->GetHardware(activate_id);
+        hardware_t &hw = eval_deme.GetHardware(activate_id);
         hw.SpawnCore(0, in_mem, false);
       }
     });
@@ -1188,55 +1327,17 @@ void Experiment::Config_HW() {
 void Experiment::Config_Tasks() {
   // Zero out task inputs.
   for (size_t i = 0; i < MAX_TASK_NUM_INPUTS; ++i) task_inputs[i] = 0;
-  // Add tasks to task set.
-  // NAND
-  task_set.AddTask("NAND", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a&b));
-  }, "NAND task");
-  // NOT
-  task_set.AddTask("NOT", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~a);
-    task.solutions.emplace_back(~b);
-  }, "NOT task");
-  // ORN
-  task_set.AddTask("ORN", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back((a|(~b)));
-    task.solutions.emplace_back((b|(~a)));
-  }, "ORN task");
-  // AND
-  task_set.AddTask("AND", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a&b);
-  }, "AND task");
-  // OR
-  task_set.AddTask("OR", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a|b);
-  }, "OR task");
-  // ANDN
-  task_set.AddTask("ANDN", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back((a&(~b)));
-    task.solutions.emplace_back((b&(~a)));
-  }, "ANDN task");
-  // NOR
-  task_set.AddTask("NOR", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a|b));
-  }, "NOR task");
-  // XOR
-  task_set.AddTask("XOR", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a^b);
-  }, "XOR task");
-  // EQU
-  task_set.AddTask("EQU", [this](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a^b));
-  }, "EQU task");
+  // Add tasks to task set: logic9 tasks (NAND, NOT, ORN, AND, OR, ANDN, NOR, XOR, EQU), skipping ECHO (last).
+  for (size_t i = 0; i < toolbelt::LOGIC9_TASK_CNT - 1; ++i) task_set.AddLogicTask(toolbelt::LOGIC9_TASKS[i]);
+
+  // Precompute task input pool (if enabled). Pool gets its own streams, derived from eval_streams'
+  // base seed, so building it doesn't consume draws from the main random number generator.
+  toolbelt::RandomStreams pool_streams(eval_streams.GetSeed((size_t)-1, 0));
+  task_input_pool.Build(task_set, TASK_INPUT_POOL_SIZE, pool_streams,
+    [](emp::Random & rnd, std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
+      inputs[0] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+      inputs[1] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+    }, EVAL_THREAD_CNT);
 }
 
 /// Mutation rules:
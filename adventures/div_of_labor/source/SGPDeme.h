@@ -97,9 +97,9 @@ public:
     grid.clear();
   }
 
-  /// Reset the deme.
+  /// Reset the deme's hardware. The deme program is kept (SetProgram overwrites it in place), so
+  /// resetting between evaluations doesn't free and reallocate every function's instructions.
   void ResetHardware() {
-    deme_program.Clear();
     for (size_t i = 0; i < grid.size(); ++i) {
       schedule[i] = i;
       grid[i].ResetHardware();
@@ -145,7 +145,7 @@ public:
 
 void SGPDeme::SetProgram(const program_t & _germ) {
   ResetHardware();                              // Reset deme hardware.
-  deme_program = _germ;
+  deme_program = _germ;                         // Copy-assign (reuses existing storage where possible).
   for (size_t i = 0; i < grid.size(); ++i) {
     grid[i].SetProgram(deme_program);           // Update grid[i]'s program.
   }
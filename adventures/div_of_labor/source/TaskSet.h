@@ -7,6 +7,8 @@
 #include <functional>
 #include <map>
 #include <unordered_set>
+#include <cstdint>
+#include <type_traits>
 
 #include "base/Ptr.h"
 #include "base/vector.h"
@@ -18,6 +20,8 @@
 #include "tools/string_utils.h"
 #include "tools/map_utils.h"
 
+#include "../../utility_belt/source/Logic9.h"
+
 
 /// Task library for logic9 changing environment experiments.
 ///  - A library of tasks with common input/output types.
@@ -51,9 +55,14 @@ protected:
   bool sollision;                                 ///< Solution collision?
   std::unordered_set<task_output_t> solution_set; ///< Used for detecting collisions between solutions.
 
+  // Logic tasks (see AddLogicTask). If every task is a logic task, SetInputs skips the per-task
+  // solution generators and computes all solutions with one LogicBattery call.
+  toolbelt::LogicBattery logic_battery;
+  emp::vector<size_t> logic_offsets;          ///< Logic task i's ops are [logic_offsets[i], logic_offsets[i+1]).
+  emp::vector<task_output_t> logic_sols;
 
 public:
-  TaskSet() : sollision(false) { ; }
+  TaskSet() : sollision(false), logic_battery(), logic_offsets(1, 0), logic_sols() { ; }
   ~TaskSet() { ; }
 
   const std::string & GetName(size_t id) const { return task_lib[id].name; }
@@ -80,9 +89,42 @@ public:
     name_map[name] = id;
   }
 
+  /// Add a task whose solutions are bitwise logic functions of the first two inputs (one solution
+  /// per op). Requires 32-bit task outputs.
+  void AddLogicTask(const std::string & name,
+                    const emp::vector<toolbelt::logic_op_t> & ops,
+                    const std::string & desc = "")
+  {
+    static_assert(std::is_same<task_output_t, uint32_t>::value, "Logic tasks require uint32_t task outputs.");
+    AddTask(name, [ops](Task & task, const task_input_t & inputs) {
+      for (toolbelt::logic_op_t op : ops) task.solutions.emplace_back(toolbelt::ApplyLogicOp(op, inputs[0], inputs[1]));
+    }, desc);
+    for (toolbelt::logic_op_t op : ops) logic_battery.AddOp(op);
+    logic_offsets.emplace_back(logic_battery.GetSize());
+  }
+
+  void AddLogicTask(const toolbelt::Logic9Task & task) {
+    AddLogicTask(task.name, emp::vector<toolbelt::logic_op_t>(task.ops, task.ops + task.op_cnt), task.desc);
+  }
+
+  /// Are all tasks logic tasks?
+  bool IsLogicOnly() const { return task_lib.size() && logic_offsets.size() == task_lib.size() + 1; }
+
 
   /// Set inputs. Reset everything.
   void SetInputs(const task_input_t & inputs) {
+    if (IsLogicOnly()) {
+      logic_sols.resize(logic_battery.GetSize());
+      logic_battery.Solve(inputs[0], inputs[1], logic_sols.data());
+      SetSolutions(logic_sols.data(), logic_offsets);
+      // Few enough solutions that pairwise comparison beats hashing.
+      for (size_t i = 0; i < logic_sols.size() && !sollision; ++i) {
+        for (size_t k = i + 1; k < logic_sols.size(); ++k) {
+          if (logic_sols[i] == logic_sols[k]) { sollision = true; break; }
+        }
+      }
+      return;
+    }
     sollision = false;
     solution_set.clear();
     for (size_t i = 0; i < task_lib.size(); ++i) {
@@ -98,6 +140,18 @@ public:
     }
   }
 
+  /// Set solutions directly (e.g., precomputed for some collision-free inputs) rather than
+  /// generating them from inputs. Solutions are laid out task by task; task i's solutions are
+  /// [sols + offsets[i], sols + offsets[i+1]).
+  void SetSolutions(const task_output_t * sols, const emp::vector<size_t> & offsets) {
+    emp_assert(offsets.size() == task_lib.size() + 1);
+    sollision = false;
+    solution_set.clear();
+    for (size_t i = 0; i < task_lib.size(); ++i) {
+      task_lib[i].solutions.assign(sols + offsets[i], sols + offsets[i+1]);
+    }
+  }
+
   // TODO: Add CheckTask functions... (return bool if given sol is solution for a task)
   bool CheckTask(size_t task_id, const task_output_t & sol) {
     emp_assert(task_id < task_lib.size());
@@ -11,11 +11,14 @@ EMP_BUILD_CONFIG( DOLConfig,
   VALUE(GENERATIONS, size_t, 100, "How many generations should we run evolution?"),
   VALUE(EVAL_TIME, size_t, 256, "Agent evaluation time"),
   VALUE(TRIAL_CNT, size_t, 3, "..."),
+  VALUE(EVAL_THREAD_CNT, size_t, 1, "How many threads should we use to evaluate the population? (results do not depend on thread count)"),
+  VALUE(EVAL_GENOTYPE_CACHE, bool, true, "Evaluate each unique genotype only once per generation? (copies reuse phenotype of first copy evaluated)"),
   VALUE(ANCESTOR_FPATH, std::string, "ancestor.gp", "Ancestor program file"),
   GROUP(TASK_GROUP, "Task Settings"),
   VALUE(TASK_BASE_REWARD, double, 1024, "Base task reward"),
   VALUE(TASK_SWITCHING_PENALTY, double, 0.5, "Penalty to reward for switching tasks"),
   VALUE(INDIV_TASK_CAP, size_t, 10, "Cap on number of tasks a single individual can get credit for."),
+  VALUE(TASK_INPUT_POOL_SIZE, size_t, 0, "Draw task inputs from a pool of this many precomputed collision-free inputs (0 to generate inputs on the fly every generation)"),
   GROUP(DEME_GROUP, "Deme Settings"),
   VALUE(DEME_WIDTH, size_t, 6, "..."),
   VALUE(DEME_HEIGHT, size_t, 6, "..."),
@@ -53,6 +56,7 @@ EMP_BUILD_CONFIG( DOLConfig,
   VALUE(SYSTEMATICS_INTERVAL, size_t, 100, "Interval to record systematics summary stats."),
   VALUE(FITNESS_INTERVAL, size_t, 100, "Interval to record fitness summary stats."),
   VALUE(POP_SNAPSHOT_INTERVAL, size_t, 10000, "Interval to take a full snapshot of the population."),
+  VALUE(POP_SNAPSHOT_FORMAT, size_t, 0, "Population snapshot file format? \n0: Text (.pop)\n1: Binary (.bpop)\n2: Both"),
   VALUE(DATA_DIRECTORY, std::string, "./", "Location to dump data output.")
 )
 
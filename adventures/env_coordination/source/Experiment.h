@@ -9,6 +9,12 @@
 #include <sys/stat.h>
 #include <algorithm>
 #include <functional>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
 
 #include "base/Ptr.h"
 #include "base/vector.h"
@@ -24,6 +30,10 @@
 #include "tools/stats.h"
 
 #include "../../utility_belt/source/utilities.h"
+#include "../../utility_belt/source/InstructionSets.h"
+#include "../../utility_belt/source/Selection.h"
+#include "../../utility_belt/source/TaskInputPool.h"
+#include "../../utility_belt/source/PopulationSnapshot.h"
 
 #include "l9_chg_env-config.h"
 #include "TaskSet.h"
@@ -40,6 +50,7 @@ constexpr double MIN_SIM_THRESH = 0.0;
 constexpr size_t RUN_ID__EVO = 0;
 constexpr size_t RUN_ID__MAPE = 1;
 constexpr size_t RUN_ID__ANALYSIS = 2;
+constexpr size_t RUN_ID__STEADY_STATE = 3;
 
 constexpr size_t ENV_TAG_GEN_ID__RANDOM = 0;
 constexpr size_t ENV_TAG_GEN_ID__LOAD = 1;
@@ -52,9 +63,17 @@ constexpr size_t ENV_CHG_METHOD_ID__SHUFFLED = 1;
 constexpr size_t ENV_CHG_METHOD_ID__REGULAR = 2;
 
 constexpr size_t TRAIT_ID__STATE = 0;
+constexpr size_t TRAIT_ID__WORKER = 1;
 
 constexpr size_t SELECTION_METHOD_ID__TOURNAMENT = 0;
 
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__TEXT = 0;
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__BINARY = 1;
+constexpr size_t POP_SNAPSHOT_FORMAT_ID__BOTH = 2;
+
+constexpr size_t ANALYSIS_METHOD_ID__TEXT_TO_BINARY = 1;
+constexpr size_t ANALYSIS_METHOD_ID__BINARY_TO_TEXT = 2;
+
 constexpr double MIN_POSSIBLE_SCORE = -32767;
 
 class Experiment {
@@ -64,12 +83,14 @@ public:
   struct Genome;
   struct Phenotype;
   class PhenotypeCache;
+  struct EvalWorker;
 
   // Type aliases
   // - Hardware aliases
   using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
   using state_t = hardware_t::State;
   using program_t = hardware_t::Program;
+  using program_pool_t = toolbelt::ObjectPool<program_t>;
   using function_t = hardware_t::Function;
   using inst_t = hardware_t::inst_t;
   using inst_lib_t = hardware_t::inst_lib_t;
@@ -83,19 +104,62 @@ public:
   using phenotype_t = Phenotype;
   using phen_cache_t = PhenotypeCache;
   using genome_t = Genome;
+  using eval_worker_t = EvalWorker;
   // - World aliases
   using world_t = emp::World<agent_t>;
   using task_io_t = uint32_t;
   using taskset_t = TaskSet<std::array<task_io_t, MAX_TASK_NUM_INPUTS>, task_io_t>;
 
+  /// Genome of agents being evolved.
+  ///  - Program is copy-on-write: copies of a genome (e.g., offspring) share their parent's
+  ///    program until a mutation actually lands (see toolbelt::CowPtr).
+  ///  - Given a program pool, program copies are recycled through it.
+  ///  - Program-level descriptors (function count, instruction entropy) are computed when the
+  ///    genome is created and whenever its program mutates, then copied along with the genome.
   struct Genome {
-    program_t program;
+    toolbelt::CowPtr<program_t> program;
     double sim_thresh;
-
-    Genome(const program_t & _p, double _s=0) : program(_p), sim_thresh(_s) { ; }
-    Genome(const Genome && in) : program(in.program), sim_thresh(in.sim_thresh) { ; }
-    Genome(const Genome & in) : program(in.program), sim_thresh(in.sim_thresh) { ; } 
-
+    size_t func_cnt;      ///< Number of functions in program
+    double inst_entropy;  ///< Shannon entropy of program's instruction (operation) distribution
+
+    Genome(const program_t & _p, double _s=0, emp::Ptr<program_pool_t> pool=nullptr)
+      : program(_p, pool), sim_thresh(_s), func_cnt(0), inst_entropy(0.0) { UpdateDescriptors(); }
+    Genome(const Genome & in) = default;
+    Genome(Genome && in) noexcept = default;
+    Genome & operator=(const Genome & in) = default;
+    Genome & operator=(Genome && in) noexcept = default;
+
+    const program_t & GetProgram() const { return program.Get(); }
+    /// Write access to program (copies program first if it's shared with other genomes).
+    /// Call UpdateDescriptors after changing the program.
+    program_t & GetMutableProgram() { return program.Edit(); }
+
+    /// Recompute program descriptors from an instruction histogram. Entropy terms are summed in
+    /// instruction ID order, as emp::ShannonEntropy does.
+    ///  - The histogram is per-thread scratch space (mutation may run on several threads), so
+    ///    this doesn't allocate once warm.
+    void UpdateDescriptors() {
+      static thread_local emp::vector<size_t> inst_hist;
+      const program_t & prog = GetProgram();
+      func_cnt = prog.GetSize();
+      inst_hist.assign(prog.inst_lib->GetSize(), 0);
+      size_t inst_cnt = 0;
+      for (size_t fID = 0; fID < prog.GetSize(); ++fID) {
+        const auto & inst_seq = prog.program[fID].inst_seq;
+        for (size_t i = 0; i < inst_seq.size(); ++i) {
+          if (inst_seq[i].id >= inst_hist.size()) inst_hist.resize(inst_seq[i].id + 1, 0);
+          ++inst_hist[inst_seq[i].id];
+        }
+        inst_cnt += inst_seq.size();
+      }
+      double ent = 0.0;
+      for (size_t id = 0; id < inst_hist.size(); ++id) {
+        if (!inst_hist[id]) continue;
+        const double p = (double)inst_hist[id] / (double)inst_cnt;
+        ent += p * emp::Log2(p);
+      }
+      inst_entropy = std::max(0.0, -1 * ent);
+    }
   };
 
   /// Agent to be evolved.
@@ -103,10 +167,13 @@ public:
     size_t agent_id;
     genome_t genome;
 
-    Agent(const program_t & _p, double _s=0) : agent_id(0), genome(_p, _s) { ; }
+    Agent(const program_t & _p, double _s=0, emp::Ptr<program_pool_t> pool=nullptr)
+      : agent_id(0), genome(_p, _s, pool) { ; }
     Agent(const genome_t & _g) : agent_id(0), genome(_g) { ; }
-    Agent(const Agent && in) : agent_id(in.GetID()), genome(in.genome) { ; }
-    Agent(const Agent & in) : agent_id(in.GetID()), genome(in.genome) { ; }
+    Agent(const Agent & in) = default;
+    Agent(Agent && in) noexcept = default;
+    Agent & operator=(const Agent & in) = default;
+    Agent & operator=(Agent && in) noexcept = default;
 
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
@@ -114,157 +181,188 @@ public:
     double GetSimilarityThreshold() const { return genome.sim_thresh; }
     void SetSimilarityThreshold(double val) { genome.sim_thresh = val; }
 
+    size_t GetFunctionCnt() const { return genome.func_cnt; }
+    double GetInstEntropy() const { return genome.inst_entropy; }
+
     genome_t & GetGenome() { return genome; }
-    program_t & GetProgram() { return genome.program; }
+    const program_t & GetProgram() const { return genome.GetProgram(); }
+    program_t & GetMutableProgram() { return genome.GetMutableProgram(); }
 
   };
   // TODO: reset phenotype on begin trial... 
   /// Phenotype of agents being evolved.
+  ///  - Lightweight handle to one (agent, evaluation) slot of a PhenotypeCache, which owns the
+  ///    actual values. Handles are cheap to copy; pass them by value.
   struct Phenotype {
-    double env_match_score;
-    size_t functions_used;
-    size_t function_cnt;
-    double inst_entropy;
-    double sim_thresh;
+    emp::Ptr<PhenotypeCache> cache;
+    size_t slot;
 
-    double score;
-
-    size_t task_cnt;
-    size_t time_all_tasks_credited;
-    size_t total_wasted_completions;
-    size_t unique_tasks_credited;
-    size_t unique_tasks_completed;
-
-    emp::vector<size_t> wasted_completions_by_task;
-    emp::vector<size_t> credited_by_task;
-    emp::vector<size_t> completed_by_task;
-
-
-    Phenotype(size_t _task_cnt=0) 
-      : env_match_score(0),
-        functions_used(0),
-        function_cnt(0),
-        inst_entropy(0),
-        sim_thresh(0),
-        score(0),
-        task_cnt(_task_cnt),
-        time_all_tasks_credited(0),
-        total_wasted_completions(0),
-        unique_tasks_credited(0),
-        unique_tasks_completed(0),
-        wasted_completions_by_task(task_cnt),
-        credited_by_task(task_cnt),
-        completed_by_task(task_cnt)
-    { ; }
+    Phenotype(emp::Ptr<PhenotypeCache> _cache, size_t _slot) : cache(_cache), slot(_slot) { ; }
 
     /// Zero out phenotype.
-    void Reset() {
-      env_match_score = 0;
-      functions_used = 0;
-      function_cnt = 0;
-      sim_thresh = 0;
-      score = 0;
-      time_all_tasks_credited = 0;
-      total_wasted_completions = 0;
-      unique_tasks_credited = 0;
-      unique_tasks_completed = 0;
-      inst_entropy = 0;
-      for (size_t i = 0; i < task_cnt; ++i) {
-        wasted_completions_by_task[i] = 0;
-        credited_by_task[i] = 0;
-        completed_by_task[i] = 0;
-      }
+    void Reset() { cache->ResetSlot(slot); }
+
+    double GetEnvMatchScore() const { return cache->GetDouble(PhenotypeCache::ENV_MATCH_SCORE, slot); }
+    size_t GetFunctionsUsed() const { return cache->GetCount(PhenotypeCache::FUNCTIONS_USED, slot); }
+    size_t GetFunctionCnt() const { return cache->GetCount(PhenotypeCache::FUNCTION_CNT, slot); }
+    double GetInstEntropy() const { return cache->GetDouble(PhenotypeCache::INST_ENTROPY, slot); }
+    double GetSimilarityThreshold() const { return cache->GetDouble(PhenotypeCache::SIM_THRESH, slot); }
+    double GetScore() const { return cache->GetDouble(PhenotypeCache::SCORE, slot); }
+    size_t GetTaskCnt() const { return cache->GetTaskCnt(); }
+    size_t GetTimeAllTasksCredited() const { return cache->GetCount(PhenotypeCache::TIME_ALL_TASKS_CREDITED, slot); }
+    size_t GetTotalWastedCompletions() const { return cache->GetCount(PhenotypeCache::TOTAL_WASTED_COMPLETIONS, slot); }
+    size_t GetUniqueTasksCredited() const { return cache->GetCount(PhenotypeCache::UNIQUE_TASKS_CREDITED, slot); }
+    size_t GetUniqueTasksCompleted() const { return cache->GetCount(PhenotypeCache::UNIQUE_TASKS_COMPLETED, slot); }
+    size_t GetWastedCompletions(size_t task_id) const {
+      return cache->GetTaskCount(PhenotypeCache::TASK_WASTED_COMPLETIONS, slot, task_id);
     }
-
-    void SetTaskCnt(size_t val) {
-      task_cnt = val;
-      wasted_completions_by_task.resize(task_cnt);
-      credited_by_task.resize(task_cnt);
-      completed_by_task.resize(task_cnt);
-      Reset();
-    }
-
-    double GetEnvMatchScore() const { return env_match_score; }
-    size_t GetFunctionsUsed() const { return functions_used; }
-    size_t GetFunctionCnt() const { return function_cnt; }
-    double GetInstEntropy() const { return inst_entropy; }
-    double GetSimilarityThreshold() const { return sim_thresh; }
-    double GetScore() const { return score; }
-    size_t GetTaskCnt() const { return task_cnt; }
-    size_t GetTimeAllTasksCredited() const { return time_all_tasks_credited; }
-    size_t GetTotalWastedCompletions() const { return total_wasted_completions; }
-    size_t GetUniqueTasksCredited() const { return unique_tasks_credited; }
-    size_t GetUniqueTasksCompleted() const { return unique_tasks_completed; }
-    size_t GetWastedCompletions(size_t task_id) const { 
-      emp_assert(task_id < wasted_completions_by_task.size());
-      return wasted_completions_by_task[task_id]; 
+    size_t GetCredited(size_t task_id) const {
+      return cache->GetTaskCount(PhenotypeCache::TASK_CREDITED, slot, task_id);
     }
-    size_t GetCredited(size_t task_id) const { 
-      emp_assert(task_id < credited_by_task.size());
-      return credited_by_task[task_id]; 
-    }
-    size_t GetCompleted(size_t task_id) const { 
-      emp_assert(task_id < completed_by_task.size());
-      return completed_by_task[task_id]; 
+    size_t GetCompleted(size_t task_id) const {
+      return cache->GetTaskCount(PhenotypeCache::TASK_COMPLETED, slot, task_id);
     }
 
-    void SetEnvMatchScore(double val) { env_match_score = val; }
-    void SetFunctionsUsed(size_t val) { functions_used = val; }
-    void SetFunctionCnt(size_t val) { function_cnt = val; }
-    void SetInstEntropy(double val) { inst_entropy = val; }
-    void SetSimilarityThreshold(double val) { sim_thresh = val; }
-    void SetScore(double val) { score = val; }
-
-    void SetTimeAllTasksCredited(size_t val) { time_all_tasks_credited = val; }
-    void SetTotalWastedCompletions(size_t val) { total_wasted_completions = val; }
-    void SetUniqueTasksCredited(size_t val) { unique_tasks_credited = val; }
-    void SetUniqueTasksCompleted(size_t val) { unique_tasks_completed = val; }
-    
-    void SetWastedCompletions(size_t task_id, size_t val) { 
-      emp_assert(task_id < wasted_completions_by_task.size());
-      wasted_completions_by_task[task_id] = val; 
+    void SetEnvMatchScore(double val) { cache->GetDouble(PhenotypeCache::ENV_MATCH_SCORE, slot) = val; }
+    void SetFunctionsUsed(size_t val) { cache->GetCount(PhenotypeCache::FUNCTIONS_USED, slot) = val; }
+    void SetFunctionCnt(size_t val) { cache->GetCount(PhenotypeCache::FUNCTION_CNT, slot) = val; }
+    void SetInstEntropy(double val) { cache->GetDouble(PhenotypeCache::INST_ENTROPY, slot) = val; }
+    void SetSimilarityThreshold(double val) { cache->GetDouble(PhenotypeCache::SIM_THRESH, slot) = val; }
+    void SetScore(double val) { cache->GetDouble(PhenotypeCache::SCORE, slot) = val; }
+
+    void SetTimeAllTasksCredited(size_t val) { cache->GetCount(PhenotypeCache::TIME_ALL_TASKS_CREDITED, slot) = val; }
+    void SetTotalWastedCompletions(size_t val) { cache->GetCount(PhenotypeCache::TOTAL_WASTED_COMPLETIONS, slot) = val; }
+    void SetUniqueTasksCredited(size_t val) { cache->GetCount(PhenotypeCache::UNIQUE_TASKS_CREDITED, slot) = val; }
+    void SetUniqueTasksCompleted(size_t val) { cache->GetCount(PhenotypeCache::UNIQUE_TASKS_COMPLETED, slot) = val; }
+
+    void SetWastedCompletions(size_t task_id, size_t val) {
+      cache->GetTaskCount(PhenotypeCache::TASK_WASTED_COMPLETIONS, slot, task_id) = val;
     }
-    void SetCredited(size_t task_id, size_t val) { 
-      emp_assert(task_id < credited_by_task.size());
-      credited_by_task[task_id] = val; 
+    void SetCredited(size_t task_id, size_t val) {
+      cache->GetTaskCount(PhenotypeCache::TASK_CREDITED, slot, task_id) = val;
     }
-    void SetCompleted(size_t task_id, size_t val) { 
-      emp_assert(task_id < completed_by_task.size());
-      completed_by_task[task_id] = val; 
+    void SetCompleted(size_t task_id, size_t val) {
+      cache->GetTaskCount(PhenotypeCache::TASK_COMPLETED, slot, task_id) = val;
     }
 
-    void IncEnvMatchScore(double val=1.0) { env_match_score += val; }
+    void IncEnvMatchScore(double val=1.0) { cache->GetDouble(PhenotypeCache::ENV_MATCH_SCORE, slot) += val; }
 
   };
 
   /// Utility class used to cache phenotypes during population evaluation.
+  ///  - Structure-of-arrays layout. Slot (agent_id * eval_cnt + eval_id) identifies an evaluation.
+  ///    Each scalar field is one contiguous array over slots, and each per-task counter is one
+  ///    contiguous [agent][eval][task] block; all double fields share one allocation and all
+  ///    count fields (scalar and per-task) share another.
   class PhenotypeCache {
+    public:
+      enum DoubleField { ENV_MATCH_SCORE=0, INST_ENTROPY, SIM_THRESH, SCORE, DOUBLE_FIELD_CNT };
+      enum CountField { FUNCTIONS_USED=0, FUNCTION_CNT, TIME_ALL_TASKS_CREDITED, TOTAL_WASTED_COMPLETIONS,
+                        UNIQUE_TASKS_CREDITED, UNIQUE_TASKS_COMPLETED, COUNT_FIELD_CNT };
+      enum TaskField { TASK_WASTED_COMPLETIONS=0, TASK_CREDITED, TASK_COMPLETED, TASK_FIELD_CNT };
+
     protected:
       size_t agent_cnt;
       size_t eval_cnt;
-      emp::vector<phenotype_t> agent_phen_cache;
+      size_t task_cnt;
+      emp::vector<double> doubles;  ///< [double field][slot]
+      emp::vector<size_t> counts;   ///< [count field][slot], followed by [task field][slot][task]
       emp::vector<size_t> agent_representative_eval;
 
+      size_t GetSlotCnt() const { return agent_cnt * eval_cnt; }
+      size_t GetTaskFieldStart(size_t field) const {
+        return (COUNT_FIELD_CNT + field * task_cnt) * GetSlotCnt();
+      }
+
+      /// (Re)allocate storage for current dimensions. Zeroes all phenotypes.
+      void Allocate() {
+        doubles.assign(DOUBLE_FIELD_CNT * GetSlotCnt(), 0.0);
+        counts.assign((COUNT_FIELD_CNT + TASK_FIELD_CNT * task_cnt) * GetSlotCnt(), 0);
+      }
+
     public:
       PhenotypeCache(size_t _agent_cnt, size_t _eval_cnt) 
-        : agent_cnt(_agent_cnt), eval_cnt(_eval_cnt), 
-          agent_phen_cache(agent_cnt * eval_cnt),
+        : agent_cnt(_agent_cnt), eval_cnt(_eval_cnt), task_cnt(0),
+          doubles(), counts(),
           agent_representative_eval(agent_cnt, 0)
-      { ; }
+      { Allocate(); }
 
       /// Resize phenotype cache. 
       void Resize(size_t _agent_cnt, size_t _eval_cnt) {
         agent_cnt = _agent_cnt;
         eval_cnt = _eval_cnt;
-        agent_phen_cache.clear();
-        agent_phen_cache.resize(agent_cnt * eval_cnt);
+        Allocate();
         agent_representative_eval.clear();
         agent_representative_eval.resize(agent_cnt, 0);
       }
 
+      /// Change number of agents, keeping cached evaluations (and representatives) of agents that
+      /// remain.
+      void SetAgentCnt(size_t _agent_cnt) {
+        if (_agent_cnt == agent_cnt) return;
+        const size_t old_slot_cnt = GetSlotCnt();
+        const size_t keep_slots = std::min(agent_cnt, _agent_cnt) * eval_cnt;
+        emp::vector<double> old_doubles;
+        emp::vector<size_t> old_counts;
+        old_doubles.swap(doubles);
+        old_counts.swap(counts);
+        agent_cnt = _agent_cnt;
+        Allocate();
+        const size_t slot_cnt = GetSlotCnt();
+        for (size_t f = 0; f < DOUBLE_FIELD_CNT; ++f) {
+          const double * from = old_doubles.data() + f * old_slot_cnt;
+          std::copy(from, from + keep_slots, doubles.data() + f * slot_cnt);
+        }
+        for (size_t f = 0; f < COUNT_FIELD_CNT; ++f) {
+          const size_t * from = old_counts.data() + f * old_slot_cnt;
+          std::copy(from, from + keep_slots, counts.data() + f * slot_cnt);
+        }
+        for (size_t f = 0; f < TASK_FIELD_CNT; ++f) {
+          const size_t * from = old_counts.data() + (COUNT_FIELD_CNT + f * task_cnt) * old_slot_cnt;
+          std::copy(from, from + keep_slots * task_cnt, counts.data() + GetTaskFieldStart(f));
+        }
+        agent_representative_eval.resize(agent_cnt, 0);
+      }
+
+      size_t GetAgentCnt() const { return agent_cnt; }
+
+      /// Set number of tasks tracked by every phenotype. Zeroes all phenotypes.
+      void SetTaskCnt(size_t _task_cnt) {
+        task_cnt = _task_cnt;
+        Allocate();
+      }
+
+      size_t GetTaskCnt() const { return task_cnt; }
+
+      double & GetDouble(size_t field, size_t slot) {
+        emp_assert(field < DOUBLE_FIELD_CNT && slot < GetSlotCnt());
+        return doubles[field * GetSlotCnt() + slot];
+      }
+
+      size_t & GetCount(size_t field, size_t slot) {
+        emp_assert(field < COUNT_FIELD_CNT && slot < GetSlotCnt());
+        return counts[field * GetSlotCnt() + slot];
+      }
+
+      size_t & GetTaskCount(size_t field, size_t slot, size_t task_id) {
+        emp_assert(field < TASK_FIELD_CNT && slot < GetSlotCnt() && task_id < task_cnt);
+        return counts[GetTaskFieldStart(field) + slot * task_cnt + task_id];
+      }
+
+      /// Zero out phenotype in given slot.
+      void ResetSlot(size_t slot) {
+        for (size_t f = 0; f < DOUBLE_FIELD_CNT; ++f) GetDouble(f, slot) = 0.0;
+        for (size_t f = 0; f < COUNT_FIELD_CNT; ++f) GetCount(f, slot) = 0;
+        for (size_t f = 0; f < TASK_FIELD_CNT; ++f) {
+          size_t * task_counts = counts.data() + GetTaskFieldStart(f) + slot * task_cnt;
+          std::fill(task_counts, task_counts + task_cnt, 0);
+        }
+      }
+
       /// Access a phenotype from the cache
-      phenotype_t & Get(size_t agent_id, size_t eval_id) {
-        return agent_phen_cache[(agent_id * eval_cnt) + eval_id];
+      phenotype_t Get(size_t agent_id, size_t eval_id) {
+        emp_assert(agent_id < agent_cnt && eval_id < eval_cnt);
+        return phenotype_t(this, (agent_id * eval_cnt) + eval_id);
       }
 
       size_t GetRepresentativeEval(size_t agent_id) {
@@ -272,25 +370,100 @@ public:
         return agent_representative_eval[agent_id];
       }
 
-      phenotype_t & GetRepresentativePhen(size_t agent_id) {
+      /// Copy all cached evaluations (and representative) of one agent to another.
+      void CopyAgent(size_t from_id, size_t to_id) {
+        emp_assert(from_id < agent_cnt && to_id < agent_cnt);
+        const size_t slot_cnt = GetSlotCnt();
+        const size_t from_slot = from_id * eval_cnt, to_slot = to_id * eval_cnt;
+        for (size_t f = 0; f < DOUBLE_FIELD_CNT; ++f) {
+          const double * from = doubles.data() + f * slot_cnt + from_slot;
+          std::copy(from, from + eval_cnt, doubles.data() + f * slot_cnt + to_slot);
+        }
+        for (size_t f = 0; f < COUNT_FIELD_CNT; ++f) {
+          const size_t * from = counts.data() + f * slot_cnt + from_slot;
+          std::copy(from, from + eval_cnt, counts.data() + f * slot_cnt + to_slot);
+        }
+        for (size_t f = 0; f < TASK_FIELD_CNT; ++f) {
+          // An agent's per-task counts are contiguous across all of its evaluations.
+          const size_t start = GetTaskFieldStart(f);
+          const size_t * from = counts.data() + start + from_slot * task_cnt;
+          std::copy(from, from + eval_cnt * task_cnt, counts.data() + start + to_slot * task_cnt);
+        }
+        agent_representative_eval[to_id] = agent_representative_eval[from_id];
+      }
+
+      phenotype_t GetRepresentativePhen(size_t agent_id) {
         return Get(agent_id, agent_representative_eval[agent_id]);
       }
 
       /// Set representative evaluation to worst-scoring evaluation.
       void SetRepresentativeEval(size_t agent_id) {
         emp_assert(agent_id < agent_cnt);
-        // agent_representative_eval[agent_id] = eval_id;
-        double score = Get(agent_id, 0).GetScore();
+        // Agent's scores are contiguous.
+        const double * scores = doubles.data() + SCORE * GetSlotCnt() + agent_id * eval_cnt;
+        double score = scores[0];
         size_t repID = 0;
         // Return the minimum score!
         for (size_t eID = 1; eID < eval_cnt; ++eID) {
-          phenotype_t & phen = Get(agent_id, eID);
-          if (phen.GetScore() < score) { score = phen.GetScore(); repID = eID; }
+          if (scores[eID] < score) { score = scores[eID]; repID = eID; }
         }
         agent_representative_eval[agent_id] = repID;
       }    
   };
 
+  /// Everything needed to evaluate a single agent: hardware, tasks, random number
+  /// generator, and trial context. Each evaluation thread owns exactly one worker.
+  struct EvalWorker {
+    size_t worker_id;
+    emp::Ptr<emp::Random> random;   ///< Worker-local random number generator
+    emp::Ptr<hardware_t> eval_hw;   ///< Worker-local SignalGP evaluation hardware
+
+    taskset_t task_set;
+    std::array<task_io_t, MAX_TASK_NUM_INPUTS> task_inputs;
+    size_t input_load_id;
+
+    size_t trial_id;
+    size_t trial_time;
+    size_t env_state;
+
+    emp::vector<size_t> env_shuffler; ///< Used for keeping track of shuffled environment cycling.
+    size_t env_shuffle_id;
+
+    toolbelt::FunctionUsage functions_used;  ///< Functions called/spawned during current trial
+
+    toolbelt::TagMatchCache<hardware_t> match_cache; ///< Memoized tag lookups for program on eval_hw
+
+    EvalWorker(size_t _id, int _seed, emp::Ptr<inst_lib_t> _ilib, emp::Ptr<event_lib_t> _elib, const taskset_t & _task_set)
+      : worker_id(_id),
+        random(emp::NewPtr<emp::Random>(_seed)),
+        eval_hw(emp::NewPtr<hardware_t>(_ilib, _elib, random)),
+        task_set(_task_set),
+        input_load_id(0),
+        trial_id(0),
+        trial_time(0),
+        env_state(0),
+        env_shuffler(),
+        env_shuffle_id(0),
+        functions_used(),
+        match_cache()
+    { 
+      for (size_t i = 0; i < MAX_TASK_NUM_INPUTS; ++i) task_inputs[i] = 0;
+    }
+
+    ~EvalWorker() {
+      eval_hw.Delete();
+      random.Delete();
+    }
+
+    /// Restart shuffled environment cycling from a fresh ordering (drawn from this worker's random
+    /// number generator), so cycling doesn't carry over from previously evaluated agents.
+    void ResetEnvShuffler() {
+      env_shuffle_id = 0;
+      for (size_t k = 0; k < env_shuffler.size(); ++k) env_shuffler[k] = k;
+      emp::Shuffle(*random, env_shuffler);
+    }
+  };
+
 protected:
   // Configurable parameters
   // == DEFAULT_GROUP ==
@@ -304,7 +477,12 @@ protected:
   size_t EVAL_TIME; 
   size_t TRIAL_CNT; 
   bool TASKS_ON; 
+  bool RECORD_TASK_TIME_STAMPS;
+  bool RECORD_FUNCTION_CALL_COUNTS;
+  size_t TASK_INPUT_POOL_SIZE;
   bool EVOLVE_SIMILARITY_THRESH;
+  size_t EVAL_THREAD_CNT;
+  bool EVAL_GENOTYPE_CACHE;
   // == ENVIRONMENT_GROUP ==
   size_t ENVIRONMENT_STATES; 
   size_t ENVIRONMENT_TAG_GENERATION_METHOD; 
@@ -319,6 +497,9 @@ protected:
   size_t TOURNAMENT_SIZE; 
   size_t SELECTION_METHOD; 
   size_t ELITE_SELECT__ELITE_CNT; 
+  size_t STEADY_STATE_UPDATE_BIRTHS;
+  bool PARALLEL_SELECTION;
+  bool MAP_ELITES_BATCH_EVAL;
   bool MAP_ELITES_AXIS__INST_ENTROPY; 
   bool MAP_ELITES_AXIS__FUNCTIONS_USED; 
   bool MAP_ELITES_AXIS__FUNCTION_CNT;
@@ -352,6 +533,7 @@ protected:
   size_t SYSTEMATICS_INTERVAL; 
   size_t FITNESS_INTERVAL; 
   size_t POP_SNAPSHOT_INTERVAL; 
+  size_t POP_SNAPSHOT_FORMAT;
   size_t DOM_SNAPSHOT_TRIAL_CNT;
   std::string DATA_DIRECTORY; 
   // == ANALYSIS_GROUP ==
@@ -362,28 +544,37 @@ protected:
   // Experiment variables
   emp::Ptr<emp::Random> random; ///< Random number generator
   emp::Ptr<world_t> world;      ///< Empirical world for evolution
+  program_pool_t program_pool;  ///< Recycled program storage for agents
 
   emp::Ptr<inst_lib_t> inst_lib;    ///< SignalGP instruction library
   emp::Ptr<event_lib_t> event_lib;  ///< SignalGP event library
 
-  emp::Ptr<hardware_t> eval_hw;     ///< SignalGP virtual hardware used for evaluation
+  emp::vector<emp::Ptr<eval_worker_t>> eval_workers; ///< One evaluation worker per evaluation thread
+  size_t snapshot_worker_id;  ///< Worker used for snapshot evaluations (must be idle while snapshotting)
+  toolbelt::RandomStreams eval_streams; ///< Per-(generation, agent, trial) random number streams for evaluation.
+  toolbelt::RandomStreams select_streams; ///< Per-(generation, tournament) streams (if PARALLEL_SELECTION)
+  toolbelt::RandomStreams mut_streams;    ///< Per-(generation, position) mutation streams (if PARALLEL_SELECTION)
+  toolbelt::RandomStreams snapshot_streams; ///< Per-(update, genotype, trial) streams for snapshot evaluations
+
+  emp::vector<double> pop_fitness;  ///< Fitness of each agent, gathered after evaluation.
+  emp::vector<agent_t> snapshot_agents;  ///< Copy of the (occupied) population that snapshots are taken from
+  emp::vector<size_t> snapshot_ids;      ///< World ID of each snapshot agent
+  emp::vector<double> snapshot_fitness;  ///< Fitness of each snapshot agent
+  size_t snapshot_dom_pos;               ///< Position of the dominant agent in snapshot_agents
+  emp::vector<size_t> parent_ids;   ///< Parents chosen by (parallel) selection, in birth order.
+  emp::vector<size_t> mape_bin_sizes;   ///< Bins per MAP-Elites axis (in axis order)
+  emp::vector<agent_t> mape_offspring;  ///< Current MAP-Elites offspring batch (if MAP_ELITES_BATCH_EVAL)
+  emp::vector<size_t> mape_free_slots;  ///< Unassigned phenotype slots for archive agents (if MAP_ELITES_BATCH_EVAL)
 
   toolbelt::SignalGPMutator<hardware_t> mutator;
 
   emp::vector<tag_t> env_state_tags;        ///< Tags associated with each environment state.
   emp::vector<tag_t> distraction_sig_tags;  ///< Tags associated with distraction signals.
-  emp::vector<size_t> env_shuffler;         ///< Used for keeping track of shuffled environment cycling.
-  size_t env_shuffle_id;
-
 
-  taskset_t task_set;
-  std::array<task_io_t, MAX_TASK_NUM_INPUTS> task_inputs;
-  size_t input_load_id;
+  taskset_t task_set;                       ///< Task set prototype (copied into each evaluation worker)
+  toolbelt::TaskInputPool<taskset_t> task_input_pool; ///< Precomputed collision-free task inputs (if TASK_INPUT_POOL_SIZE > 0)
 
   size_t update;
-  size_t trial_id;
-  size_t trial_time;
-  size_t env_state;
 
   size_t max_pop_size;
 
@@ -391,7 +582,6 @@ protected:
   double best_score;
 
   double max_inst_entropy;
-  std::unordered_set<size_t> functions_used;
 
   phen_cache_t phen_cache;
 
@@ -407,19 +597,22 @@ protected:
   // Systematics signals
   emp::Signal<void(size_t)> do_pop_snapshot_sig;      ///< Triggered if we should take a snapshot of the population (as defined by POP_SNAPSHOT_INTERVAL). Should call appropriate functions to take snapshot.
 
-  emp::Signal<void(agent_t &)> begin_agent_eval_sig;  ///< Triggered at beginning of agent evaluation (might be multiple trials)
-  emp::Signal<void(agent_t &)> end_agent_eval_sig;  ///< Triggered at beginning of agent evaluation (might be multiple trials)
+  // Evaluation signals are passed the worker doing the evaluation; they may be triggered
+  // concurrently (by different workers), so actions should only touch worker-local state
+  // and the evaluated agent's phenotype cache slots.
+  emp::Signal<void(eval_worker_t &, agent_t &)> begin_agent_eval_sig;  ///< Triggered at beginning of agent evaluation (might be multiple trials)
+  emp::Signal<void(eval_worker_t &, agent_t &)> end_agent_eval_sig;  ///< Triggered at beginning of agent evaluation (might be multiple trials)
   
-  emp::Signal<void(agent_t &)> begin_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
-  emp::Signal<void(agent_t &)> do_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
-  emp::Signal<void(agent_t &)> end_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
+  emp::Signal<void(eval_worker_t &, agent_t &)> begin_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
+  emp::Signal<void(eval_worker_t &, agent_t &)> do_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
+  emp::Signal<void(eval_worker_t &, agent_t &)> end_agent_trial_sig; ///< Triggered at the beginning of an agent trial.
 
-  emp::Signal<void(agent_t &)> do_agent_advance_sig; ///< When triggered, advance SignalGP evaluation hardware
-  emp::Signal<void(void)> do_env_advance_sig;
+  emp::Signal<void(eval_worker_t &, agent_t &)> do_agent_advance_sig; ///< When triggered, advance SignalGP evaluation hardware
+  emp::Signal<void(eval_worker_t &)> do_env_advance_sig;
 
 
   // A few flexible functors!
-  std::function<double(agent_t &)> calc_score;
+  std::function<double(eval_worker_t &, agent_t &)> calc_score;
   
   // For MAP-Elites
   std::function<double(agent_t &)> inst_ent_fun;
@@ -429,29 +622,72 @@ protected:
 
   std::function<size_t(agent_t &, emp::Random &)> mutate_agent;
 
-  /// Reset logic tasks, guaranteeing no solution collisions among the tasks.
-  void ResetTasks() {
-    task_inputs[0] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
-    task_inputs[1] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
-    task_set.SetInputs(task_inputs);
-    while (task_set.IsCollision()) {
-      task_inputs[0] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
-      task_inputs[1] = random->GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
-      task_set.SetInputs(task_inputs);
+  /// Reset worker's logic tasks, guaranteeing no solution collisions among the tasks.
+  void ResetTasks(eval_worker_t & worker) {
+    emp::Random & rnd = *worker.random;
+    if (task_input_pool.GetSize()) {
+      const size_t pool_id = rnd.GetUInt(task_input_pool.GetSize());
+      worker.task_inputs = task_input_pool.GetInputs(pool_id);
+      task_input_pool.Load(pool_id, worker.task_set);
+      return;
     }
+    worker.task_inputs[0] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+    worker.task_inputs[1] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+    worker.task_set.SetInputs(worker.task_inputs);
+    while (worker.task_set.IsCollision()) {
+      worker.task_inputs[0] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+      worker.task_inputs[1] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+      worker.task_set.SetInputs(worker.task_inputs);
+    }
+  }
+
+  /// Get the evaluation worker that owns the given hardware.
+  eval_worker_t & GetWorker(hardware_t & hw) {
+    return *eval_workers[(size_t)hw.GetTrait(TRAIT_ID__WORKER)];
   }
 
-  /// Evaluate given agent.
-  void Evaluate(agent_t & agent) {
-    begin_agent_eval_sig.Trigger(agent);
-    for (trial_id = 0; trial_id < TRIAL_CNT; ++trial_id) {
-      begin_agent_trial_sig.Trigger(agent);
-      do_agent_trial_sig.Trigger(agent);
-      end_agent_trial_sig.Trigger(agent);
+  /// Content hash of agent's genotype (program and similarity threshold).
+  size_t GetGenotypeHash(agent_t & agent) {
+    return toolbelt::HashCombine(toolbelt::HashProgram(agent.GetProgram()), 
+                                 std::hash<double>()(agent.GetSimilarityThreshold()));
+  }
+
+  /// Do agents have the same genotype (program and similarity threshold)?
+  bool SameGenotype(agent_t & a, agent_t & b) {
+    return a.GetSimilarityThreshold() == b.GetSimilarityThreshold()
+           && toolbelt::SameProgram(a.GetProgram(), b.GetProgram());
+  }
+
+  /// Evaluate given agent using given worker.
+  /// Each trial draws from its own (generation, genotype, trial) random number stream, so it
+  /// does not matter which worker evaluates an agent or in what order agents are evaluated, and
+  /// identical genotypes are evaluated identically.
+  void Evaluate(eval_worker_t & worker, agent_t & agent) { Evaluate(worker, agent, eval_streams, update); }
+
+  /// Evaluate given agent using given worker, drawing from given streams of given generation
+  /// (steady-state evolution keys streams by birth rather than by update; snapshots use
+  /// snapshot_streams so they don't replay evaluation trials).
+  void Evaluate(eval_worker_t & worker, agent_t & agent, const toolbelt::RandomStreams & streams, size_t stream_gen) {
+    const size_t genotype_hash = GetGenotypeHash(agent);
+    begin_agent_eval_sig.Trigger(worker, agent);
+    for (worker.trial_id = 0; worker.trial_id < TRIAL_CNT; ++worker.trial_id) {
+      streams.SeedStream(*worker.random, stream_gen, genotype_hash, worker.trial_id);
+      begin_agent_trial_sig.Trigger(worker, agent);
+      do_agent_trial_sig.Trigger(worker, agent);
+      end_agent_trial_sig.Trigger(worker, agent);
     }
-    end_agent_eval_sig.Trigger(agent);
+    end_agent_eval_sig.Trigger(worker, agent);
   }
 
+  /// Evaluate entire population, distributing agents over all evaluation workers.
+  /// If EVAL_GENOTYPE_CACHE, only the first copy of each unique genotype is evaluated.
+  void EvaluatePopulation();
+
+  /// Call fun(worker, i) for every i in [0, n), distributing indices over all evaluation workers
+  /// (one thread per worker).
+  template <typename FUN>
+  void ForEachOnWorkers(size_t n, FUN fun);
+
   /// Scratch/test function.
   void Test() {
     std::cout << "Testing experiment!" << std::endl;
@@ -460,12 +696,10 @@ protected:
 
 public:
   Experiment(const L9ChgEnvConfig & config)
-    : mutator(),
-      input_load_id(0),
+    : snapshot_worker_id(0),
+      snapshot_dom_pos(0),
+      mutator(),
       update(0),
-      trial_id(0),
-      trial_time(0),
-      env_state(0),
       max_pop_size(0),
       dom_agent_id(0),
       best_score(0),
@@ -484,7 +718,12 @@ public:
     EVAL_TIME = config.EVAL_TIME(); 
     TRIAL_CNT = config.TRIAL_CNT(); 
     TASKS_ON = config.TASKS_ON(); 
+    RECORD_TASK_TIME_STAMPS = config.RECORD_TASK_TIME_STAMPS();
+    RECORD_FUNCTION_CALL_COUNTS = config.RECORD_FUNCTION_CALL_COUNTS();
+    TASK_INPUT_POOL_SIZE = config.TASK_INPUT_POOL_SIZE();
     EVOLVE_SIMILARITY_THRESH = config.EVOLVE_SIMILARITY_THRESH();
+    EVAL_THREAD_CNT = config.EVAL_THREAD_CNT();
+    EVAL_GENOTYPE_CACHE = config.EVAL_GENOTYPE_CACHE();
     // == ENVIRONMENT_GROUP ==
     ENVIRONMENT_STATES = config.ENVIRONMENT_STATES(); 
     ENVIRONMENT_TAG_GENERATION_METHOD = config.ENVIRONMENT_TAG_GENERATION_METHOD(); 
@@ -499,6 +738,9 @@ public:
     TOURNAMENT_SIZE = config.TOURNAMENT_SIZE(); 
     SELECTION_METHOD = config.SELECTION_METHOD(); 
     ELITE_SELECT__ELITE_CNT = config.ELITE_SELECT__ELITE_CNT(); 
+    STEADY_STATE_UPDATE_BIRTHS = config.STEADY_STATE_UPDATE_BIRTHS();
+    PARALLEL_SELECTION = config.PARALLEL_SELECTION();
+    MAP_ELITES_BATCH_EVAL = config.MAP_ELITES_BATCH_EVAL();
     MAP_ELITES_AXIS__INST_ENTROPY = config.MAP_ELITES_AXIS__INST_ENTROPY(); 
     MAP_ELITES_AXIS__FUNCTIONS_USED = config.MAP_ELITES_AXIS__FUNCTIONS_USED(); 
     MAP_ELITES_AXIS__FUNCTION_CNT = config.MAP_ELITES_AXIS__FUNCTION_CNT();
@@ -532,6 +774,7 @@ public:
     SYSTEMATICS_INTERVAL = config.SYSTEMATICS_INTERVAL(); 
     FITNESS_INTERVAL = config.FITNESS_INTERVAL(); 
     POP_SNAPSHOT_INTERVAL = config.POP_SNAPSHOT_INTERVAL(); 
+    POP_SNAPSHOT_FORMAT = config.POP_SNAPSHOT_FORMAT();
     DOM_SNAPSHOT_TRIAL_CNT = config.DOM_SNAPSHOT_TRIAL_CNT();
     DATA_DIRECTORY = config.DATA_DIRECTORY(); 
     // == ANALYSIS_GROUP ==
@@ -541,6 +784,14 @@ public:
 
     // Create a new random number generator
     random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+    // Evaluation random number streams are derived from the experiment's random seed.
+    eval_streams.SetBaseSeed(random->GetUInt());
+    // Selection/mutation streams are derived from eval_streams' (rather than drawing from random,
+    // which would change results when PARALLEL_SELECTION is off).
+    select_streams.SetBaseSeed(eval_streams.GetSeed((size_t)-2, 0));
+    mut_streams.SetBaseSeed(eval_streams.GetSeed((size_t)-3, 0));
+    // Snapshots get their own streams so they don't replay the trials agents were evaluated on.
+    snapshot_streams.SetBaseSeed(eval_streams.GetSeed((size_t)-4, 0));
 
     // Make the world!
     world = emp::NewPtr<world_t>(*random, "World");
@@ -554,6 +805,11 @@ public:
       exit(-1);
     }
 
+    if (EVAL_THREAD_CNT < 1) {
+      std::cout << "Cannot run experiment with EVAL_THREAD_CNT < 1. Exiting..." << std::endl;
+      exit(-1);
+    }
+
     // Configure the environment tags.
     switch(ENVIRONMENT_TAG_GENERATION_METHOD) {
       case ENV_TAG_GEN_ID__RANDOM: {
@@ -585,14 +841,9 @@ public:
       std::cout << std::endl;
     }
 
-    // Populate environment shuffler!
-    for (size_t i = 0; i < env_state_tags.size(); ++i) env_shuffler.emplace_back(i);
-    env_shuffle_id = 0;
-
-    // Make empty instruction/event libraries. Make hardware.
+    // Make empty instruction/event libraries.
     inst_lib = emp::NewPtr<inst_lib_t>();
     event_lib = emp::NewPtr<event_lib_t>();
-    eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, random);
 
     // Configure the mutator
     mutator.SetProgMinFuncCnt(SGP_PROG_MIN_FUNC_CNT);
@@ -612,6 +863,7 @@ public:
     // Configure hardware, etc
     DoConfig__Tasks();
     DoConfig__Hardware();
+    DoConfig__EvalWorkers();
 
     switch (RUN_MODE) {
       case RUN_ID__EVO: {
@@ -624,6 +876,11 @@ public:
         DoConfig__MAPElites();
         break;
       }
+      case RUN_ID__STEADY_STATE: {
+        DoConfig__Experiment();
+        DoConfig__SteadyState();
+        break;
+      }
       case RUN_ID__ANALYSIS: {
         DoConfig__Analysis();
         break;
@@ -638,7 +895,7 @@ public:
   }
 
   ~Experiment() {
-    eval_hw.Delete();
+    for (size_t i = 0; i < eval_workers.size(); ++i) eval_workers[i].Delete();
     event_lib.Delete();
     inst_lib.Delete();
     world.Delete();
@@ -648,18 +905,54 @@ public:
   // === Run functions ===
   void Run();
   void RunStep();
+  /// Steady-state evolution: every evaluation worker (thread) repeatedly picks a parent by
+  /// tournament, mutates and evaluates a copy, and inserts it back into the population (replacing
+  /// the loser of a reverse tournament). No generation barrier.
+  void RunSteadyState();
 
   // === Evolution functions ===
   double GetFitness(agent_t & agent);
+  /// Representative phenotype of the dominant agent. In batched MAP-Elites, dom_agent_id is an
+  /// archive cell, and the agent in it has its own phenotype slot.
+  phenotype_t GetDominantPhen() {
+    if (RUN_MODE == RUN_ID__MAPE && MAP_ELITES_BATCH_EVAL) {
+      return phen_cache.GetRepresentativePhen(world->GetOrg(dom_agent_id).GetID());
+    }
+    return phen_cache.GetRepresentativePhen(dom_agent_id);
+  }
 
   size_t MutateSimilarityThresh(agent_t & agent, emp::Random & rnd);
 
+  /// Elite + tournament selection against pop_fitness: picks all parents up front (tournaments
+  /// run across EVAL_THREAD_CNT threads), then gives birth to them in order.
+  void DoSelection__Parallel();
+  /// Mutate agents at positions [start, pop size) across EVAL_THREAD_CNT threads.
+  void DoMutations__Parallel(size_t start);
+  /// Get an unassigned phenotype slot for an agent entering the MAP-Elites archive (growing the
+  /// phenotype cache if needed).
+  size_t AcquireMAPSlot();
+  /// Fill the (empty) MAP-Elites archive with the initial population, which population
+  /// initialization collected in mape_offspring (see InjectGenome): seeds are evaluated first and
+  /// then placed exactly as offspring are.
+  void SeedMAPArchive();
+  /// One update of batched MAP-Elites: pick POP_SIZE random parents, mutate and evaluate their
+  /// offspring across all evaluation workers, then insert the offspring into the archive in order.
+  void DoMAPElites__Batch();
+  /// Evaluate mape_offspring (in their phenotype slots) across all evaluation workers. If
+  /// EVAL_GENOTYPE_CACHE, only the first copy of each unique genotype is evaluated.
+  void EvaluateMAPOffspring();
+  /// Insert (evaluated) mape_offspring into the MAP-Elites archive, in order, keeping track of
+  /// the archive's dominant agent.
+  void InsertMAPOffspring();
+
   // === Config functions ===
   void DoConfig__Hardware();
   void DoConfig__Tasks();
+  void DoConfig__EvalWorkers();
 
   void DoConfig__Evolution();  ///< Setup evolutionary algorithm
   void DoConfig__MAPElites();  ///< Setup MAP-Elites algorithm
+  void DoConfig__SteadyState(); ///< Setup steady-state evolution
   void DoConfig__Experiment(); ///< Setup experiment
   void DoConfig__Analysis();   ///< Setup analysis
 
@@ -669,9 +962,23 @@ public:
 
   void InitPopulation__FromAncestorFile();
   void InitPopulation__Random();
+  /// Add copy_cnt agents with given genome to the initial population.
+  void InjectGenome(const genome_t & genome, size_t copy_cnt);
 
 
   // === Systematics Functions ===
+  /// Copy population (agents share programs copy-on-write, so this is cheap), fitnesses, and
+  /// dominant agent for the snapshot functions, which only read these copies. Steady-state
+  /// evolution copies while holding the population lock and snapshots after releasing it.
+  void CopySnapshotPopulation();
+  /// Phenotype slot to evaluate a snapshot agent (with given world ID) in. Steady-state evolution
+  /// uses the snapshot worker's scratch slot (other workers are copying into population slots), and
+  /// MAP-Elites uses slot 0 (archive cells don't all have a slot).
+  size_t GetSnapshotSlot(size_t world_id) const {
+    if (RUN_MODE == RUN_ID__STEADY_STATE) return POP_SIZE + snapshot_worker_id;
+    if (RUN_MODE == RUN_ID__MAPE) return 0;
+    return world_id;
+  }
   /// Snapshot all programs for current update
   void Snapshot__Programs(size_t u); 
   /// Snapshot population statistics for current update
@@ -685,16 +992,14 @@ public:
 
   // === Extra SignalGP instruction definitions ===
   // -- Execution control instructions --
-  static void Inst_Fork(hardware_t & hw, const inst_t & inst);      
-  static void Inst_Terminate(hardware_t & hw, const inst_t & inst); 
-  static void Inst_Nand(hardware_t & hw, const inst_t & inst);
+  void Inst_Fork(hardware_t & hw, const inst_t & inst);      
 
   void Inst_Load1(hardware_t & hw, const inst_t & inst);
   void Inst_Load2(hardware_t & hw, const inst_t & inst);
   void Inst_Submit(hardware_t & hw, const inst_t & inst);
 
   // === SignalGP event definitions ===
-  static void HandleEvent__EnvSignal_ED(hardware_t & hw, const event_t & event);
+  void HandleEvent__EnvSignal_ED(hardware_t & hw, const event_t & event);
   static void HandleEvent__EnvSignal_IMP(hardware_t & hw, const event_t & event);
   static void DispatchEvent__EnvSignal_ED(hardware_t & hw, const event_t & event);
   static void DispatchEvent__EnvSignal_IMP(hardware_t & hw, const event_t & event);
@@ -704,46 +1009,45 @@ public:
 // == Extra SignalGP instructions ==
 void Experiment::Inst_Fork(hardware_t & hw, const inst_t & inst) {
   state_t & state = hw.GetCurState();
-  hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem, false);
-}
-
-void Experiment::Inst_Terminate(hardware_t & hw, const inst_t & inst)  {
-  // Pop all the call states from current core.
-  exec_stk_t & core = hw.GetCurCore();
-  core.resize(0);
-}
-
-void Experiment::Inst_Nand(hardware_t & hw, const inst_t & inst) {
-  state_t & state = hw.GetCurState();
-  const task_io_t a = (task_io_t)state.GetLocal(inst.args[0]);
-  const task_io_t b = (task_io_t)state.GetLocal(inst.args[1]);
-  state.SetLocal(inst.args[2], ~(a&b));
+  size_t fID;
+  if (GetWorker(hw).match_cache.FindFunction(hw, inst.affinity, hw.GetMinBindThresh(), false, fID)) {
+    hw.SpawnCore(fID, state.local_mem, false);
+  }
 }
 
 void Experiment::Inst_Load1(hardware_t & hw, const inst_t & inst) {
+  eval_worker_t & worker = GetWorker(hw);
   state_t & state = hw.GetCurState();
-  state.SetLocal(inst.args[0], task_inputs[input_load_id]); // Load input.
-  input_load_id += 1;
-  if (input_load_id >= task_inputs.size()) input_load_id = 0; // Update load ID.
+  state.SetLocal(inst.args[0], worker.task_inputs[worker.input_load_id]); // Load input.
+  worker.input_load_id += 1;
+  if (worker.input_load_id >= worker.task_inputs.size()) worker.input_load_id = 0; // Update load ID.
 }
 
 void Experiment::Inst_Load2(hardware_t & hw, const inst_t & inst) {
+  eval_worker_t & worker = GetWorker(hw);
   state_t & state = hw.GetCurState();
-  state.SetLocal(inst.args[0], task_inputs[0]);
-  state.SetLocal(inst.args[1], task_inputs[1]);
+  state.SetLocal(inst.args[0], worker.task_inputs[0]);
+  state.SetLocal(inst.args[1], worker.task_inputs[1]);
 }
 
 void Experiment::Inst_Submit(hardware_t & hw, const inst_t & inst) {
+  eval_worker_t & worker = GetWorker(hw);
   state_t & state = hw.GetCurState();
   // Credit?
-  const bool credit = hw.GetTrait(TRAIT_ID__STATE) == env_state;
+  const bool credit = hw.GetTrait(TRAIT_ID__STATE) == worker.env_state;
   // Submit!
-  task_set.Submit((task_io_t)state.GetLocal(inst.args[0]), trial_time, credit);
+  worker.task_set.Submit((task_io_t)state.GetLocal(inst.args[0]), worker.trial_time, credit);
 }
 
 // === SignalGP events ===
 // Events.
-void Experiment::HandleEvent__EnvSignal_ED(hardware_t & hw, const event_t & event) { hw.SpawnCore(event.affinity, hw.GetMinBindThresh(), event.msg); }
+void Experiment::HandleEvent__EnvSignal_ED(hardware_t & hw, const event_t & event) { 
+  // Environment tags are fixed for the whole run, so these lookups are almost always cached.
+  size_t fID;
+  if (GetWorker(hw).match_cache.FindFunction(hw, event.affinity, hw.GetMinBindThresh(), false, fID)) {
+    hw.SpawnCore(fID, event.msg, false);
+  }
+}
 void Experiment::HandleEvent__EnvSignal_IMP(hardware_t & hw, const event_t & event) { return; }
 void Experiment::DispatchEvent__EnvSignal_ED(hardware_t & hw, const event_t & event) { hw.QueueEvent(event); }
 void Experiment::DispatchEvent__EnvSignal_IMP(hardware_t & hw, const event_t & event) { return; }
@@ -760,6 +1064,11 @@ void Experiment::Run() {
       }
       break;
     }
+    case RUN_ID__STEADY_STATE: {
+      do_begin_run_setup_sig.Trigger();
+      RunSteadyState();
+      break;
+    }
     case RUN_ID__ANALYSIS: {
       do_analysis_sig.Trigger();
       break;
@@ -777,6 +1086,130 @@ void Experiment::RunStep() {
   do_world_update_sig.Trigger();
 }
 
+void Experiment::RunSteadyState() {
+  const size_t births_per_update = (STEADY_STATE_UPDATE_BIRTHS) ? STEADY_STATE_UPDATE_BIRTHS : POP_SIZE;
+  const size_t total_births = GENERATIONS * births_per_update;
+  // Evaluate initial population.
+  update = 0;
+  EvaluatePopulation();
+  pop_fitness.resize(world->GetSize());
+  best_score = MIN_POSSIBLE_SCORE;
+  dom_agent_id = 0;
+  for (size_t id = 0; id < world->GetSize(); ++id) {
+    pop_fitness[id] = GetFitness(world->GetOrg(id));
+    if (pop_fitness[id] > best_score) { best_score = pop_fitness[id]; dom_agent_id = id; }
+  }
+  std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
+
+  // Population (world, pop_fitness, population phenotypes) is only touched while holding pop_mutex;
+  // mutation and evaluation of offspring happen outside of it. Offspring are evaluated into their
+  // worker's scratch phenotype slot (POP_SIZE + worker ID) and copied in on insertion.
+  //  - Birth b's parent/victim tournaments, mutations, and evaluation draw from streams keyed by b.
+  //    With more than one worker, which population a birth sees depends on timing.
+  //  - Population snapshots are taken outside of pop_mutex, one at a time (snapshot_mutex).
+  std::mutex pop_mutex;
+  std::mutex snapshot_mutex;
+  size_t next_birth = 0;
+  size_t births = 0;
+  auto do_work = [this, &pop_mutex, &snapshot_mutex, &next_birth, &births, births_per_update, total_births](eval_worker_t & worker) {
+    const size_t scratch_id = POP_SIZE + worker.worker_id;
+    emp::Random rnd(1);
+    std::unique_lock<std::mutex> lock(pop_mutex);
+    while (next_birth < total_births) {
+      const size_t birth_id = next_birth++;
+      select_streams.SeedStream(rnd, birth_id, 0);
+      const size_t parent_id = toolbelt::RunTournament(pop_fitness, TOURNAMENT_SIZE, rnd);
+      agent_t child(world->GetOrg(parent_id));
+      lock.unlock();
+
+      mut_streams.SeedStream(rnd, birth_id, 0);
+      mutate_agent(child, rnd);
+      child.SetID(scratch_id);
+      this->Evaluate(worker, child, eval_streams, birth_id);
+      const double fitness = GetFitness(child);
+
+      lock.lock();
+      // Replace the least fit of a tournament (never the current best agent).
+      select_streams.SeedStream(rnd, birth_id, 1);
+      const size_t victim_id = toolbelt::RunTournament(pop_fitness, TOURNAMENT_SIZE, rnd, true, dom_agent_id);
+      child.SetID(victim_id);
+      world->InjectAt(child, emp::WorldPosition(victim_id));
+      phen_cache.CopyAgent(scratch_id, victim_id);
+      pop_fitness[victim_id] = fitness;
+      if (fitness > best_score) { best_score = fitness; dom_agent_id = victim_id; }
+      if (++births % births_per_update == 0) {
+        // emp::World isn't thread-safe (other workers insert offspring), so it's updated under the
+        // lock. Snapshots are taken from a copy of the population after releasing the lock.
+        const size_t u = update;
+        const bool do_snapshot = (u % POP_SNAPSHOT_INTERVAL == 0);
+        std::unique_lock<std::mutex> snapshot_lock(snapshot_mutex, std::defer_lock);
+        if (do_snapshot) {
+          // The previous snapshot may still be using the copy (and its worker's scratch slot).
+          snapshot_lock.lock();
+          // This worker is idle until it's done snapshotting, so it does the snapshot evaluations.
+          snapshot_worker_id = worker.worker_id;
+          CopySnapshotPopulation();
+        }
+        world->Update();
+        ++update;
+        std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
+        if (do_snapshot) {
+          lock.unlock();
+          do_pop_snapshot_sig.Trigger(u);
+          snapshot_lock.unlock();
+          lock.lock();
+        }
+      }
+    }
+  };
+  // Worker 0 runs on the calling thread.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < eval_workers.size(); ++i) {
+    threads.emplace_back(do_work, std::ref(*eval_workers[i]));
+  }
+  do_work(*eval_workers[0]);
+  for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+  snapshot_worker_id = 0;
+}
+
+void Experiment::EvaluatePopulation() {
+  const size_t pop_size = world->GetSize();
+  // Figure out which agents need to be evaluated (and which are copies of an evaluated genotype).
+  emp::vector<size_t> eval_ids;
+  emp::vector<std::pair<size_t, size_t>> copies; // (copy id, evaluated id)
+  toolbelt::GenotypeIndex genotypes;
+  auto same_genotype = [this](size_t a, size_t b) { return SameGenotype(world->GetOrg(a), world->GetOrg(b)); };
+  for (size_t id = 0; id < pop_size; ++id) {
+    agent_t & our_hero = world->GetOrg(id);
+    our_hero.SetID(id);
+    if (!EVAL_GENOTYPE_CACHE) { eval_ids.emplace_back(id); continue; }
+    const size_t eval_id = genotypes.FindOrAdd(GetGenotypeHash(our_hero), id, same_genotype);
+    if (eval_id == id) eval_ids.emplace_back(id);
+    else copies.emplace_back(id, eval_id);
+  }
+  ForEachOnWorkers(eval_ids.size(), [this, &eval_ids](eval_worker_t & worker, size_t i) {
+    this->Evaluate(worker, world->GetOrg(eval_ids[i]));
+  });
+  // Copies reuse the phenotypes of their evaluated genotype.
+  for (size_t i = 0; i < copies.size(); ++i) phen_cache.CopyAgent(copies[i].second, copies[i].first);
+}
+
+template <typename FUN>
+void Experiment::ForEachOnWorkers(size_t n, FUN fun) {
+  std::atomic<size_t> next_id(0);
+  // Each worker pulls the next index until there are none left.
+  auto do_work = [n, &next_id, &fun](eval_worker_t & worker) {
+    for (size_t i = next_id++; i < n; i = next_id++) fun(worker, i);
+  };
+  // Worker 0 runs on the calling thread.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < eval_workers.size(); ++i) {
+    threads.emplace_back(do_work, std::ref(*eval_workers[i]));
+  }
+  do_work(*eval_workers[0]);
+  for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+}
+
 // === Evolution functions ===
 double Experiment::GetFitness(agent_t & agent) {
   const size_t aID = agent.GetID();
@@ -796,6 +1229,127 @@ size_t Experiment::MutateSimilarityThresh(agent_t & agent, emp::Random & rnd) {
   return 0;
 }
 
+void Experiment::DoSelection__Parallel() {
+  emp_assert(pop_fitness.size() == world->GetSize());
+  // 1) Pick parents: elites first, then tournament winners (same birth order as EliteSelect +
+  //    TournamentSelect).
+  parent_ids = toolbelt::SelectElites(pop_fitness, ELITE_SELECT__ELITE_CNT);
+  const size_t elite_cnt = parent_ids.size();
+  emp::vector<size_t> winners;
+  toolbelt::SelectTournaments(pop_fitness, TOURNAMENT_SIZE, POP_SIZE - elite_cnt, select_streams,
+                              update, winners, EVAL_THREAD_CNT);
+  parent_ids.insert(parent_ids.end(), winners.begin(), winners.end());
+  // 2) Reproduce. Births go through the world (for systematics/signals), but with copy-on-write
+  //    genomes a birth only shares its parent's program; copying happens during (parallel) mutation.
+  for (size_t i = 0; i < parent_ids.size(); ++i) {
+    world->DoBirth(world->GetGenomeAt(parent_ids[i]), parent_ids[i]);
+  }
+}
+
+void Experiment::DoMutations__Parallel(size_t start) {
+  const size_t pop_size = world->GetSize();
+  if (start >= pop_size) return;
+  toolbelt::ParallelFor(pop_size - start, EVAL_THREAD_CNT, [this, start](size_t i, emp::Random & rnd) {
+    const size_t pos = start + i;
+    if (!world->IsOccupied(pos)) return;
+    mut_streams.SeedStream(rnd, update, pos);
+    mutate_agent(world->GetOrg(pos), rnd);
+  });
+}
+
+size_t Experiment::AcquireMAPSlot() {
+  if (mape_free_slots.empty()) {
+    // Grow geometrically; new slots go on the free list (lowest slot on top).
+    const size_t old_cnt = phen_cache.GetAgentCnt();
+    const size_t new_cnt = std::max<size_t>(old_cnt + 1, 2 * old_cnt);
+    phen_cache.SetAgentCnt(new_cnt);
+    for (size_t slot = new_cnt; slot > old_cnt; --slot) mape_free_slots.emplace_back(slot - 1);
+  }
+  const size_t slot = mape_free_slots.back();
+  mape_free_slots.pop_back();
+  return slot;
+}
+
+void Experiment::SeedMAPArchive() {
+  // Seeds use the offspring slots (growing them if there are more seeds than POP_SIZE; no
+  // archive slots have been handed out yet).
+  if (mape_offspring.size() > phen_cache.GetAgentCnt()) phen_cache.SetAgentCnt(mape_offspring.size());
+  for (size_t i = 0; i < mape_offspring.size(); ++i) mape_offspring[i].SetID(i);
+  EvaluateMAPOffspring();
+  InsertMAPOffspring();
+}
+
+void Experiment::DoMAPElites__Batch() {
+  const size_t batch_size = POP_SIZE;
+  // 1) Pick parents (uniformly from occupied cells, as emp::RandomSelect does) and copy them.
+  //    Offspring i gets phenotype slot i.
+  mape_offspring.clear();
+  for (size_t i = 0; i < batch_size; ++i) {
+    mape_offspring.emplace_back(world->GetOrg(world->GetRandomOrgID()));
+    mape_offspring.back().SetID(i);
+  }
+  // 2) Mutate. Offspring i draws from mutation stream (update, i).
+  ForEachOnWorkers(batch_size, [this](eval_worker_t & worker, size_t i) {
+    mut_streams.SeedStream(*worker.random, update, i);
+    mutate_agent(mape_offspring[i], *worker.random);
+  });
+  // 3) Evaluate.
+  EvaluateMAPOffspring();
+  // 4) Insert offspring into the archive.
+  InsertMAPOffspring();
+}
+
+void Experiment::EvaluateMAPOffspring() {
+  const size_t batch_size = mape_offspring.size();
+  emp::vector<size_t> eval_ids;
+  emp::vector<std::pair<size_t, size_t>> copies; // (copy id, evaluated id)
+  toolbelt::GenotypeIndex genotypes;
+  auto same_genotype = [this](size_t a, size_t b) { return SameGenotype(mape_offspring[a], mape_offspring[b]); };
+  for (size_t i = 0; i < batch_size; ++i) {
+    if (!EVAL_GENOTYPE_CACHE) { eval_ids.emplace_back(i); continue; }
+    const size_t eval_id = genotypes.FindOrAdd(GetGenotypeHash(mape_offspring[i]), i, same_genotype);
+    if (eval_id == i) eval_ids.emplace_back(i);
+    else copies.emplace_back(i, eval_id);
+  }
+  ForEachOnWorkers(eval_ids.size(), [this, &eval_ids](eval_worker_t & worker, size_t i) {
+    this->Evaluate(worker, mape_offspring[eval_ids[i]]);
+  });
+  for (size_t i = 0; i < copies.size(); ++i) {
+    phen_cache.CopyAgent(mape_offspring[copies[i].second].GetID(), mape_offspring[copies[i].first].GetID());
+  }
+}
+
+void Experiment::InsertMAPOffspring() {
+  // An offspring takes its cell if the cell is empty or its occupant is no fitter (as in
+  // emp::SetMapElites). It moves into the occupant's phenotype slot, or into a newly assigned one
+  // if the cell was empty.
+  //  - Occupants are only ever replaced by agents at least as fit, so the archive's best fitness
+  //    never drops: the dominant agent (dom_agent_id, a cell) only changes to a fitter offspring.
+  auto & traits = world->GetPhenotypes();
+  const size_t batch_size = mape_offspring.size();
+  for (size_t i = 0; i < batch_size; ++i) {
+    agent_t & offspring = mape_offspring[i];
+    const double fitness = GetFitness(offspring);
+    if (fitness > best_score) best_score = fitness;
+    const size_t cell_id = traits.EvalBin(offspring, mape_bin_sizes);
+    size_t slot = 0;
+    if (world->IsOccupied(cell_id)) {
+      agent_t & occupant = world->GetOrg(cell_id);
+      if (GetFitness(occupant) > fitness) continue;
+      slot = occupant.GetID();
+    } else {
+      slot = AcquireMAPSlot();
+    }
+    phen_cache.CopyAgent(offspring.GetID(), slot);
+    offspring.SetID(slot);
+    world->InjectAt(offspring, emp::WorldPosition(cell_id));
+    if (dom_agent_id == cell_id || dom_agent_id >= world->GetSize() || !world->IsOccupied(dom_agent_id)
+        || fitness > GetFitness(world->GetOrg(dom_agent_id))) {
+      dom_agent_id = cell_id;
+    }
+  }
+}
+
 // == utility functions ==
 
 /// Utility function to save environment tags.
@@ -868,6 +1422,29 @@ void Experiment::GenerateEnvTags__FromTagFile() {
 
 void Experiment::InitPopulation__FromAncestorFile() {
   std::cout << "Initializing population from ancestor file (" << ANCESTOR_FPATH << ")!" << std::endl;
+  // Binary population snapshot? Seed the population with its programs (cycling through them to
+  // fill the population).
+  if (toolbelt::PopulationFileView::IsPopulationFile(ANCESTOR_FPATH)) {
+    toolbelt::PopulationFileView pop_file;
+    std::string error;
+    if (!pop_file.Open(ANCESTOR_FPATH, error) || !pop_file.IsCompatible<hardware_t>(*inst_lib, error)) {
+      std::cout << "Failed to load ancestor population (" << error << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+    if (pop_file.GetProgramCnt() == 0) {
+      std::cout << "Ancestor population file (" << ANCESTOR_FPATH << ") is empty. Exiting..." << std::endl;
+      exit(-1);
+    }
+    std::cout << " --- Ancestor population: " << pop_file.GetProgramCnt() << " programs ---" << std::endl;
+    program_t ancestor_prog(inst_lib);
+    for (size_t i = 0; i < POP_SIZE; ++i) {
+      const size_t pID = i % pop_file.GetProgramCnt();
+      pop_file.LoadProgram(pID, ancestor_prog);
+      genome_t ancestor_genome(ancestor_prog, pop_file.GetAux(pID), &program_pool);
+      InjectGenome(ancestor_genome, 1);
+    }
+    return;
+  }
   // Configure the ancestor program.
   program_t ancestor_prog(inst_lib);
   std::ifstream ancestor_fstream(ANCESTOR_FPATH);
@@ -879,8 +1456,8 @@ void Experiment::InitPopulation__FromAncestorFile() {
   std::cout << " --- Ancestor program: ---" << std::endl;
   ancestor_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
-  genome_t ancestor_genome(ancestor_prog, SGP_HW_MIN_BIND_THRESH);
-  world->Inject(ancestor_genome, POP_SIZE);    // Inject population!
+  genome_t ancestor_genome(ancestor_prog, SGP_HW_MIN_BIND_THRESH, &program_pool);
+  InjectGenome(ancestor_genome, POP_SIZE);    // Inject population!
 }
 
 void Experiment::InitPopulation__Random() {
@@ -903,115 +1480,153 @@ void Experiment::InitPopulation__Random() {
       }
       ancestor_prog.PushFunction(new_fun);
     }
-    genome_t ancestor_genome(ancestor_prog, random->GetDouble(MIN_SIM_THRESH, MAX_SIM_THRESH));
-    world->Inject(ancestor_genome, 1);  
+    genome_t ancestor_genome(ancestor_prog, random->GetDouble(MIN_SIM_THRESH, MAX_SIM_THRESH), &program_pool);
+    InjectGenome(ancestor_genome, 1);
   }
   std::cout << "Done randomly initializing population!" << std::endl;
 }
 
+void Experiment::InjectGenome(const genome_t & genome, size_t copy_cnt) {
+  if (RUN_MODE == RUN_ID__MAPE && MAP_ELITES_BATCH_EVAL) {
+    // Batched MAP-Elites places seeds only once they've been evaluated (see SeedMAPArchive);
+    // emp::SetMapElites' inject would bin them (and settle conflicts) on unevaluated phenotypes.
+    for (size_t i = 0; i < copy_cnt; ++i) mape_offspring.emplace_back(genome);
+    return;
+  }
+  world->Inject(genome, copy_cnt);
+}
+
 // == Systematics functions ==
+void Experiment::CopySnapshotPopulation() {
+  snapshot_agents.clear();
+  snapshot_ids.clear();
+  snapshot_fitness.clear();
+  snapshot_dom_pos = 0;
+  for (size_t id = 0; id < world->GetSize(); ++id) {
+    if (!world->IsOccupied(id)) continue;
+    if (id == dom_agent_id) snapshot_dom_pos = snapshot_agents.size();
+    snapshot_ids.emplace_back(id);
+    snapshot_fitness.emplace_back(world->CalcFitnessID(id));
+    snapshot_agents.emplace_back(world->GetOrg(id));
+  }
+}
+
 void Experiment::Snapshot__Programs(size_t u) {
   std::string snapshot_dir = DATA_DIRECTORY + "pop_" + emp::to_string((int)u);
   mkdir(snapshot_dir.c_str(), ACCESSPERMS);
+  const std::string snapshot_fpath = snapshot_dir + "/pop_" + emp::to_string((int)u);
+  // Binary snapshot (.bpop): same ID/fitness/similarity threshold as the text snapshot.
+  if (POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BINARY || POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BOTH) {
+    toolbelt::PopulationFileWriter<hardware_t> pop_writer(*inst_lib);
+    for (size_t i = 0; i < snapshot_agents.size(); ++i) {
+      pop_writer.Add(snapshot_agents[i].GetProgram(), snapshot_ids[i], snapshot_fitness[i], snapshot_agents[i].GetSimilarityThreshold());
+    }
+    if (!pop_writer.Write(snapshot_fpath + ".bpop")) {
+      std::cout << "Failed to write population snapshot (" << snapshot_fpath << ".bpop)." << std::endl;
+    }
+  }
+  if (POP_SNAPSHOT_FORMAT == POP_SNAPSHOT_FORMAT_ID__BINARY) return;
   // For each program in the population, dump the full program description in a single file.
-  std::ofstream prog_ofstream(snapshot_dir + "/pop_" + emp::to_string((int)u) + ".pop");
-  for (size_t i = 0; i < world->GetSize(); ++i) {
-    if (!world->IsOccupied(i)) continue;
-    prog_ofstream << "==="<<i<<":"<<world->CalcFitnessID(i)<<","<<world->GetOrg(i).GetSimilarityThreshold()<<"===\n";
-    Agent & agent = world->GetOrg(i);
-    agent.GetProgram().PrintProgramFull(prog_ofstream);
+  std::ofstream prog_ofstream(snapshot_fpath + ".pop");
+  for (size_t i = 0; i < snapshot_agents.size(); ++i) {
+    prog_ofstream << "==="<<snapshot_ids[i]<<":"<<snapshot_fitness[i]<<","<<snapshot_agents[i].GetSimilarityThreshold()<<"===\n";
+    // PrintProgramFull isn't const; print a copy rather than unsharing the agent's program.
+    program_t prog(snapshot_agents[i].GetProgram());
+    prog.PrintProgramFull(prog_ofstream);
   }
   prog_ofstream.close();
 }
 
 void Experiment::Snapshot__PopulationStats(size_t u) {
-  std::string snapshot_dir = DATA_DIRECTORY + "pop_" + emp::to_string((int)update);
+  std::string snapshot_dir = DATA_DIRECTORY + "pop_" + emp::to_string((int)u);
   mkdir(snapshot_dir.c_str(), ACCESSPERMS);
-  emp::DataFile file(snapshot_dir + "/pop_" + emp::to_string((int)update) + ".csv");
+  emp::DataFile file(snapshot_dir + "/pop_" + emp::to_string((int)u) + ".csv");
   
-  std::function<size_t(void)> get_update = [this](){ return world->GetUpdate(); };
+  std::function<size_t(void)> get_update = [u](){ return u; };
   file.AddFun(get_update, "update", "Update");
 
+  // Agents are evaluated (and their phenotypes read) in slot phen_id.
   size_t world_id = 0;
+  size_t phen_id = 0;
   std::function<size_t(void)> get_id = [this, &world_id]() { return world_id; };
   file.AddFun(get_id, "id", "...");
 
-  std::function<size_t(void)> get_func_cnt = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<size_t(void)> get_func_cnt = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetFunctionCnt();
   };
   file.AddFun(get_func_cnt, "func_cnt", "Number of functions in program");
 
-  std::function<size_t(void)> get_func_used = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<size_t(void)> get_func_used = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetFunctionsUsed();
   };
   file.AddFun(get_func_used, "func_used", "...");
 
-  std::function<double(void)> get_inst_ent = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<double(void)> get_inst_ent = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetInstEntropy();
   };
   file.AddFun(get_inst_ent, "inst_entropy", "...");
 
-  std::function<double(void)> get_sim_thresh = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<double(void)> get_sim_thresh = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetSimilarityThreshold();
   };
   file.AddFun(get_sim_thresh, "sim_thresh", "...");
 
-  std::function<double(void)> get_score = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<double(void)> get_score = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetScore();
   };
   file.AddFun(get_score, "score", "...");
 
-  std::function<size_t(void)> get_env_match_score = [this, &world_id]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+  std::function<size_t(void)> get_env_match_score = [this, &phen_id]() {
+    phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
     return phen.GetEnvMatchScore();
   };
   file.AddFun(get_env_match_score, "env_matches", "...");
 
   if (TASKS_ON) {
-    std::function<size_t(void)> get_time_all_tasks_credited = [this, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+    std::function<size_t(void)> get_time_all_tasks_credited = [this, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
       return phen.GetTimeAllTasksCredited();
     };
     file.AddFun(get_time_all_tasks_credited, "time_all_tasks_credited", "...");
 
-    std::function<size_t(void)> get_unique_tasks_completed = [this, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+    std::function<size_t(void)> get_unique_tasks_completed = [this, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
       return phen.GetUniqueTasksCompleted();
     };
     file.AddFun(get_unique_tasks_completed, "total_unique_tasks_completed", "...");
 
-    std::function<size_t(void)> get_total_wasted_completions = [this, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+    std::function<size_t(void)> get_total_wasted_completions = [this, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
       return phen.GetTotalWastedCompletions();
     };
     file.AddFun(get_total_wasted_completions, "total_wasted_completions", "...");
 
-    std::function<size_t(void)> get_unique_tasks_credited = [this, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+    std::function<size_t(void)> get_unique_tasks_credited = [this, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
       return phen.GetUniqueTasksCredited();
     };
     file.AddFun(get_unique_tasks_credited, "total_unique_tasks_credited", "...");
 
     for (size_t i = 0; i < task_set.GetSize(); ++i) {
-      std::function<size_t(void)> get_wasted = [this, i, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+      std::function<size_t(void)> get_wasted = [this, i, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
         return phen.GetWastedCompletions(i);
       };
       file.AddFun(get_wasted, "wasted_"+task_set.GetName(i), "...");
 
-      std::function<size_t(void)> get_completed = [this, i, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+      std::function<size_t(void)> get_completed = [this, i, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
         return phen.GetCompleted(i);
       };
       file.AddFun(get_completed, "completed_"+task_set.GetName(i), "...");
 
-      std::function<size_t(void)> get_credited = [this, i, &world_id]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(world_id);
+      std::function<size_t(void)> get_credited = [this, i, &phen_id]() {
+      phenotype_t phen = phen_cache.GetRepresentativePhen(phen_id);
         return phen.GetCredited(i);
       };
       file.AddFun(get_credited, "credited_"+task_set.GetName(i), "...");
@@ -1020,33 +1635,42 @@ void Experiment::Snapshot__PopulationStats(size_t u) {
   file.PrintHeaderKeys();
 
   // Loop through population, evaluate, update file.
-  for (world_id = 0; world_id < world->GetSize(); ++world_id) {
-    if (!world->IsOccupied(world_id)) continue;
-    agent_t & agent = world->GetOrg(world_id);
-    agent.SetID(world_id);
-    this->Evaluate(agent);
+  eval_worker_t & worker = *eval_workers[snapshot_worker_id];
+  for (size_t i = 0; i < snapshot_agents.size(); ++i) {
+    world_id = snapshot_ids[i];
+    phen_id = GetSnapshotSlot(world_id);
+    agent_t agent(snapshot_agents[i]);
+    agent.SetID(phen_id);
+    this->Evaluate(worker, agent, snapshot_streams, u);
     file.Update();
   }
 }
 
 void Experiment::Snapshot__Dominant(size_t u) {
-  emp_assert(RUN_MODE == RUN_ID__EVO);
+  emp_assert(RUN_MODE == RUN_ID__EVO || RUN_MODE == RUN_ID__STEADY_STATE);
 
   std::string snapshot_dir = DATA_DIRECTORY + "pop_" + emp::to_string((int)u);
   mkdir(snapshot_dir.c_str(), ACCESSPERMS);
   
   emp::vector<double> scores(DOM_SNAPSHOT_TRIAL_CNT,0);
+  emp::vector<size_t> func_calls;  // Calls/spawns per function, summed over trials (if RECORD_FUNCTION_CALL_COUNTS)
   
-  agent_t & dom_agent = world->GetOrg(dom_agent_id);
+  agent_t dom_agent(snapshot_agents[snapshot_dom_pos]);
+  dom_agent.SetID(GetSnapshotSlot(snapshot_ids[snapshot_dom_pos]));
+  eval_worker_t & worker = *eval_workers[snapshot_worker_id];
 
-  begin_agent_eval_sig.Trigger(dom_agent);
+  begin_agent_eval_sig.Trigger(worker, dom_agent);
   for (size_t i = 0; i < DOM_SNAPSHOT_TRIAL_CNT; ++i) {
-    trial_id = 0;
-    begin_agent_trial_sig.Trigger(dom_agent);
-    do_agent_trial_sig.Trigger(dom_agent);
-    end_agent_trial_sig.Trigger(dom_agent);
+    worker.trial_id = 0;
+    snapshot_streams.SeedStream(*worker.random, u, GetGenotypeHash(dom_agent), i);
+    begin_agent_trial_sig.Trigger(worker, dom_agent);
+    do_agent_trial_sig.Trigger(worker, dom_agent);
+    end_agent_trial_sig.Trigger(worker, dom_agent);
     // Grab score
-    scores[i] = phen_cache.Get(dom_agent.GetID(), trial_id).GetScore();
+    scores[i] = phen_cache.Get(dom_agent.GetID(), worker.trial_id).GetScore();
+    const emp::vector<size_t> & trial_calls = worker.functions_used.GetCallCnts();
+    if (func_calls.size() < trial_calls.size()) func_calls.resize(trial_calls.size(), 0);
+    for (size_t fID = 0; fID < trial_calls.size(); ++fID) func_calls[fID] += trial_calls[fID];
   }
 
   // Output stuff to file.
@@ -1058,6 +1682,15 @@ void Experiment::Snapshot__Dominant(size_t u) {
     prog_ofstream << "\n" << tID << "," << scores[tID];
   }
   prog_ofstream.close();
+
+  if (RECORD_FUNCTION_CALL_COUNTS) {
+    std::ofstream calls_ofstream(snapshot_dir + "/dom_func_calls_" + emp::to_string((int)u) + ".csv");
+    calls_ofstream << "function_id,calls";
+    for (size_t fID = 0; fID < func_calls.size(); ++fID) {
+      calls_ofstream << "\n" << fID << "," << func_calls[fID];
+    }
+    calls_ofstream.close();
+  }
 }
 
 void Experiment::Snapshot__MAP(size_t u) {
@@ -1070,23 +1703,26 @@ void Experiment::Snapshot__MAP(size_t u) {
   // Fill out the header.
   prog_ofstream << "agent_id,trial,fitness,func_cnt,func_used,inst_entropy,sim_thresh";
   
+  eval_worker_t & worker = *eval_workers[0];
   for (size_t aID = 0; aID < world->GetSize(); ++aID) {
     if (!world->IsOccupied(aID)) continue;
-    agent_t & agent = world->GetOrg(aID);
-
+    // Evaluate a copy in slot 0 (scratch in both MAP-Elites modes) so archive phenotypes are kept.
+    agent_t agent(world->GetOrg(aID));
+    agent.SetID(0);
 
     emp::vector<double> scores(DOM_SNAPSHOT_TRIAL_CNT, 0);
     emp::vector<size_t> func_used(DOM_SNAPSHOT_TRIAL_CNT, 0);
 
-    begin_agent_eval_sig.Trigger(agent);
+    begin_agent_eval_sig.Trigger(worker, agent);
     for (size_t i = 0; i < DOM_SNAPSHOT_TRIAL_CNT; ++i) {
-      trial_id = 0;
-      begin_agent_trial_sig.Trigger(agent);
-      do_agent_trial_sig.Trigger(agent);
-      end_agent_trial_sig.Trigger(agent);
+      worker.trial_id = 0;
+      snapshot_streams.SeedStream(*worker.random, u, GetGenotypeHash(agent), i);
+      begin_agent_trial_sig.Trigger(worker, agent);
+      do_agent_trial_sig.Trigger(worker, agent);
+      end_agent_trial_sig.Trigger(worker, agent);
       // Grab score
-      scores[i] = phen_cache.Get(agent.GetID(), trial_id).GetScore();
-      func_used[i] = phen_cache.Get(agent.GetID(), trial_id).GetFunctionsUsed();
+      scores[i] = phen_cache.Get(agent.GetID(), worker.trial_id).GetScore();
+      func_used[i] = phen_cache.Get(agent.GetID(), worker.trial_id).GetFunctionsUsed();
     }
     double entropy = phen_cache.Get(agent.GetID(), 0).GetInstEntropy();
     double sim_thresh = phen_cache.Get(agent.GetID(), 0).GetSimilarityThreshold();
@@ -1107,81 +1743,81 @@ emp::DataFile & Experiment::AddDominantFile(const std::string & fpath="dominant.
   file.AddFun(get_update, "update", "Update");
 
   std::function<size_t(void)> get_func_cnt = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetFunctionCnt();
   };
   file.AddFun(get_func_cnt, "func_cnt", "Number of functions in program");
 
   std::function<size_t(void)> get_func_used = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetFunctionsUsed();
   };
   file.AddFun(get_func_used, "func_used", "Number of functions used by program");
 
   std::function<double(void)> get_inst_ent = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetInstEntropy();
   };
   file.AddFun(get_inst_ent, "inst_entropy", "Instruction entropy of program");
 
   std::function<double(void)> get_sim_thresh = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetSimilarityThreshold();
   };
   file.AddFun(get_sim_thresh, "sim_thresh", "Similarity threshold of program");
 
   std::function<double(void)> get_score = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetScore();
   };
   file.AddFun(get_score, "score", "Score of program");
 
   std::function<size_t(void)> get_env_match_score = [this]() {
-    phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+    phenotype_t phen = GetDominantPhen();
     return phen.GetEnvMatchScore();
   };
   file.AddFun(get_env_match_score, "env_matches", "Number of environment states matched by agent");
 
   if (TASKS_ON) { 
     std::function<size_t(void)> get_time_all_tasks_credited = [this]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+      phenotype_t phen = GetDominantPhen();
       return phen.GetTimeAllTasksCredited();
     };
     file.AddFun(get_time_all_tasks_credited, "time_all_tasks_credited", "...");
 
     std::function<size_t(void)> get_unique_tasks_completed = [this]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+      phenotype_t phen = GetDominantPhen();
       return phen.GetUniqueTasksCompleted();
     };
     file.AddFun(get_unique_tasks_completed, "total_unique_tasks_completed", "...");
 
     std::function<size_t(void)> get_total_wasted_completions = [this]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+      phenotype_t phen = GetDominantPhen();
       return phen.GetTotalWastedCompletions();
     };
     file.AddFun(get_total_wasted_completions, "total_wasted_completions", "...");
 
     std::function<size_t(void)> get_unique_tasks_credited = [this]() {
-      phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+      phenotype_t phen = GetDominantPhen();
       return phen.GetUniqueTasksCredited();
     };
     file.AddFun(get_unique_tasks_credited, "total_unique_tasks_credited", "...");
 
     for (size_t i = 0; i < task_set.GetSize(); ++i) {
       std::function<size_t(void)> get_wasted = [this, i]() {
-        phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+        phenotype_t phen = GetDominantPhen();
         return phen.GetWastedCompletions(i);
       };
       file.AddFun(get_wasted, "wasted_"+task_set.GetName(i), "...");
 
       std::function<size_t(void)> get_completed = [this, i]() {
-        phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+        phenotype_t phen = GetDominantPhen();
         return phen.GetCompleted(i);
       };
       file.AddFun(get_completed, "completed_"+task_set.GetName(i), "...");
 
       std::function<size_t(void)> get_credited = [this, i]() {
-        phenotype_t & phen = phen_cache.GetRepresentativePhen(dom_agent_id);
+        phenotype_t phen = GetDominantPhen();
         return phen.GetCredited(i);
       };
       file.AddFun(get_credited, "credited_"+task_set.GetName(i), "...");
@@ -1195,103 +1831,33 @@ emp::DataFile & Experiment::AddDominantFile(const std::string & fpath="dominant.
 
 // == Configuration functions ==
 void Experiment::DoConfig__Tasks() {
-  // Zero out task inputs.
-  for (size_t i = 0; i < MAX_TASK_NUM_INPUTS; ++i) task_inputs[i] = 0;
-  // Add tasks to task set.
-  // NAND
-  task_set.AddTask("NAND", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a&b));
-  }, "NAND task");
-  // NOT
-  task_set.AddTask("NOT", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~a);
-    task.solutions.emplace_back(~b);
-  }, "NOT task");
-  // ORN
-  task_set.AddTask("ORN", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back((a|(~b)));
-    task.solutions.emplace_back((b|(~a)));
-  }, "ORN task");
-  // AND
-  task_set.AddTask("AND", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a&b);
-  }, "AND task");
-  // OR
-  task_set.AddTask("OR", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a|b);
-  }, "OR task");
-  // ANDN
-  task_set.AddTask("ANDN", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back((a&(~b)));
-    task.solutions.emplace_back((b&(~a)));
-  }, "ANDN task");
-  // NOR
-  task_set.AddTask("NOR", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a|b));
-  }, "NOR task");
-  // XOR
-  task_set.AddTask("XOR", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a^b);
-  }, "XOR task");
-  // EQU
-  task_set.AddTask("EQU", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(~(a^b));
-  }, "EQU task");
-  // ECHO
-  task_set.AddTask("ECHO", [](taskset_t::Task & task, const std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
-    const task_io_t a = inputs[0], b = inputs[1];
-    task.solutions.emplace_back(a);
-    task.solutions.emplace_back(b);
-  }, "ECHO task");
+  task_set.SetRecordTimeStamps(RECORD_TASK_TIME_STAMPS);
+  // Add tasks to task set: logic9 tasks (NAND, NOT, ORN, AND, OR, ANDN, NOR, XOR, EQU) + ECHO.
+  for (size_t i = 0; i < toolbelt::LOGIC9_TASK_CNT; ++i) task_set.AddLogicTask(toolbelt::LOGIC9_TASKS[i]);
+
+  // Precompute task input pool (if enabled). Pool gets its own streams, derived from eval_streams'
+  // base seed, so building it doesn't consume draws from the main random number generator.
+  toolbelt::RandomStreams pool_streams(eval_streams.GetSeed((size_t)-1, 0));
+  task_input_pool.Build(task_set, TASK_INPUT_POOL_SIZE, pool_streams,
+    [](emp::Random & rnd, std::array<task_io_t, MAX_TASK_NUM_INPUTS> & inputs) {
+      inputs[0] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+      inputs[1] = rnd.GetUInt(MIN_TASK_INPUT, MAX_TASK_INPUT);
+    }, EVAL_THREAD_CNT);
 }
 
 void Experiment::DoConfig__Hardware() {
   // - Setup the instruction set. -
   // Standard instructions:
-  inst_lib->AddInst("Inc", hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
-  inst_lib->AddInst("Dec", hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
-  inst_lib->AddInst("Not", hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
-  inst_lib->AddInst("Add", hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
-  inst_lib->AddInst("Sub", hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
-  inst_lib->AddInst("Mult", hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
-  inst_lib->AddInst("Div", hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
-  inst_lib->AddInst("Mod", hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
-  inst_lib->AddInst("TestEqu", hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
-  inst_lib->AddInst("TestNEqu", hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
-  inst_lib->AddInst("TestLess", hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
-  inst_lib->AddInst("If", hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("While", hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Countdown", hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Close", hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
-  inst_lib->AddInst("Break", hardware_t::Inst_Break, 0, "Break out of current block.");
-  inst_lib->AddInst("Call", hardware_t::Inst_Call, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
-  inst_lib->AddInst("Return", hardware_t::Inst_Return, 0, "Return from current function if possible.");
-  inst_lib->AddInst("SetMem", hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
-  inst_lib->AddInst("CopyMem", hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
-  inst_lib->AddInst("SwapMem", hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
-  inst_lib->AddInst("Input", hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
-  inst_lib->AddInst("Output", hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
-  inst_lib->AddInst("Commit", hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Pull", hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Nop", hardware_t::Inst_Nop, 0, "No operation.");
-  inst_lib->AddInst("Fork", Inst_Fork, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.");
-  inst_lib->AddInst("Terminate", Inst_Terminate, 0, "Kill current thread.");
+  toolbelt::AddStandardInstructions<hardware_t>(*inst_lib, hardware_t::Inst_Call);
+  inst_lib->AddInst("Fork", [this](hardware_t & hw, const inst_t & inst) { this->Inst_Fork(hw, inst); }, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.");
+  inst_lib->AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
 
   // Add experiment-specific instructions
   if (TASKS_ON) {
     inst_lib->AddInst("Load-1", [this](hardware_t & hw, const inst_t & inst) { this->Inst_Load1(hw, inst); }, 1, "WM[ARG1] = TaskInput[LOAD_ID]; LOAD_ID++;");
     inst_lib->AddInst("Load-2", [this](hardware_t & hw, const inst_t & inst) { this->Inst_Load2(hw, inst); }, 2, "WM[ARG1] = TASKINPUT[0]; WM[ARG2] = TASKINPUT[1];");
     inst_lib->AddInst("Submit", [this](hardware_t & hw, const inst_t & inst) { this->Inst_Submit(hw, inst); }, 1, "Submit WM[ARG1] as potential task solution.");
-    inst_lib->AddInst("Nand", Inst_Nand, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
+    inst_lib->AddInst("Nand", toolbelt::Inst_Nand<hardware_t, task_io_t>, 3, "WM[ARG3]=~(WM[ARG1]&WM[ARG2])");
   }
 
   // Add 1 set state instruction for every possible environment state.
@@ -1305,7 +1871,7 @@ void Experiment::DoConfig__Hardware() {
   // Add events!
   if (SGP_ENVIRONMENT_SIGNALS) {
     // Use event-driven events.
-    event_lib->AddEvent("EnvSignal", HandleEvent__EnvSignal_ED, "");
+    event_lib->AddEvent("EnvSignal", [this](hardware_t & hw, const event_t & event) { this->HandleEvent__EnvSignal_ED(hw, event); }, "");
     event_lib->RegisterDispatchFun("EnvSignal", DispatchEvent__EnvSignal_ED);
   } else {
     // Use nop events.
@@ -1320,7 +1886,7 @@ void Experiment::DoConfig__Hardware() {
       inst_lib->AddInst("SenseState-" + emp::to_string(i),
         [this, i](hardware_t & hw, const inst_t & inst) {
           state_t & state = hw.GetCurState();
-          state.SetLocal(inst.args[0], this->env_state==i);
+          state.SetLocal(inst.args[0], this->GetWorker(hw).env_state==i);
         }, 1, "Sense if current environment state is " + emp::to_string(i));
     }
   } else {
@@ -1332,33 +1898,21 @@ void Experiment::DoConfig__Hardware() {
     }
   }
 
-  // Configure evaluation hardware.
-  eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
-  eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
-  eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
-
   max_inst_entropy = -1 * emp::Log2(1.0/((double)inst_lib->GetSize()));
   std::cout << "Maximum instruction entropy: " << max_inst_entropy << std::endl;
 
   inst_ent_fun = [](agent_t & agent) {
-    emp::vector<inst_t> inst_seq;
-    program_t & prog = agent.GetProgram();
-    for (size_t i = 0; i < prog.GetSize(); ++i) {
-      for (size_t k = 0; k < prog[i].GetSize(); ++k) {
-        inst_seq.emplace_back(prog[i][k].id);
-      }
-    }
-    const double ent = emp::ShannonEntropy(inst_seq);
-    if (ent < 0.0) return 0.0;
-    return ent;
+    return agent.GetInstEntropy();
   };
   
+  // Functions used during the agent's last evaluation trial (read from its phenotype slot, so only
+  // meaningful once the agent has been evaluated).
   func_used_fun = [this](agent_t & agent) {
-    return (int)functions_used.size();
+    return (int)phen_cache.Get(agent.GetID(), TRIAL_CNT - 1).GetFunctionsUsed();
   };
 
   func_cnt_fun = [](agent_t & agent) {
-    return (int)agent.GetProgram().GetSize();
+    return (int)agent.GetFunctionCnt();
   };
 
   get_sim_thresh_fun = [](agent_t & agent) {
@@ -1367,6 +1921,33 @@ void Experiment::DoConfig__Hardware() {
 
 }
 
+void Experiment::DoConfig__EvalWorkers() {
+  for (size_t i = 0; i < EVAL_THREAD_CNT; ++i) {
+    // Workers are reseeded from eval_streams before every trial. Their initial seeds also come from
+    // eval_streams (a reserved key) rather than random, which the world draws from: the number of
+    // workers must not change the world's random draws.
+    const int seed = eval_streams.GetSeed((size_t)-5, i);
+    eval_workers.emplace_back(emp::NewPtr<eval_worker_t>(i, seed, inst_lib, event_lib, task_set));
+    eval_worker_t & worker = *eval_workers.back();
+    // Populate environment shuffler!
+    for (size_t k = 0; k < env_state_tags.size(); ++k) worker.env_shuffler.emplace_back(k);
+    worker.functions_used = toolbelt::FunctionUsage(SGP_PROG_MAX_FUNC_CNT, RECORD_FUNCTION_CALL_COUNTS);
+    // Configure evaluation hardware.
+    emp::Ptr<hardware_t> eval_hw = worker.eval_hw;
+    eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
+    eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
+    eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+    eval_hw->SetTrait(TRAIT_ID__WORKER, i);
+    eval_hw->OnBeforeFuncCall([&worker](hardware_t & hw, size_t fID) {
+      worker.functions_used.Mark(fID);
+    });
+    eval_hw->OnBeforeCoreSpawn([&worker](hardware_t & hw, size_t fID) {
+      worker.functions_used.Mark(fID);
+    });
+  }
+  std::cout << "Evaluation workers: " << eval_workers.size() << std::endl;
+}
+
 void Experiment::DoConfig__Evolution() {
   std::cout << "Configure good 'old evolution experiment." << std::endl;
 
@@ -1377,14 +1958,13 @@ void Experiment::DoConfig__Evolution() {
   do_evaluation_sig.AddAction([this]() {
     best_score = MIN_POSSIBLE_SCORE;
     dom_agent_id = 0;
+    // Evaluate! (across all evaluation workers)
+    this->EvaluatePopulation();
+    pop_fitness.resize(world->GetSize());
     for (size_t id = 0; id < world->GetSize(); ++id) {
-      // Load and configure the agent.
-      agent_t & our_hero = world->GetOrg(id);
-      our_hero.SetID(id);
-      // Evaluate!
-      this->Evaluate(our_hero);
       // Grab the score!
-      double score = GetFitness(our_hero);
+      double score = GetFitness(world->GetOrg(id));
+      pop_fitness[id] = score;
       if (score > best_score) { best_score = score; dom_agent_id = id; }
     }
     std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
@@ -1396,7 +1976,8 @@ void Experiment::DoConfig__Evolution() {
 
   // This assumes that this config function gets called after the general experiment config function.
   do_world_update_sig.AddAction([this]() {
-    world->DoMutations(ELITE_SELECT__ELITE_CNT);
+    if (PARALLEL_SELECTION) this->DoMutations__Parallel(ELITE_SELECT__ELITE_CNT);
+    else world->DoMutations(ELITE_SELECT__ELITE_CNT);
   });
 
   do_pop_snapshot_sig.AddAction([this](size_t u) { this->Snapshot__Dominant(u); });
@@ -1404,6 +1985,10 @@ void Experiment::DoConfig__Evolution() {
   // Setup selection
   switch (SELECTION_METHOD) {
     case SELECTION_METHOD_ID__TOURNAMENT: {
+      if (PARALLEL_SELECTION) {
+        do_selection_sig.AddAction([this]() { this->DoSelection__Parallel(); });
+        break;
+      }
       do_selection_sig.AddAction([this]() {
         emp::EliteSelect(*world, ELITE_SELECT__ELITE_CNT, 1);
         emp::TournamentSelect(*world, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT);
@@ -1418,24 +2003,50 @@ void Experiment::DoConfig__Evolution() {
 
 }
 
+void Experiment::DoConfig__SteadyState() {
+  std::cout << "Configure steady-state evolution." << std::endl;
+
+  // Offspring replace agents in place (see RunSteadyState); world->Update() only advances the
+  // update (data files/snapshots) every STEADY_STATE_UPDATE_BIRTHS births. RunSteadyState updates
+  // the world and triggers snapshots itself (not through do_world_update_sig).
+  world->SetPopStruct_Mixed(false);
+  world->SetFitFun([this](agent_t & agent) { return this->GetFitness(agent); });
+
+  // One scratch phenotype slot per evaluation worker for offspring being evaluated.
+  phen_cache.Resize(POP_SIZE + EVAL_THREAD_CNT, TRIAL_CNT);
+
+  do_begin_run_setup_sig.AddAction([this]() {
+    this->AddDominantFile(DATA_DIRECTORY + "dominant.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
+  });
+
+  do_pop_snapshot_sig.AddAction([this](size_t u) { this->Snapshot__Dominant(u); });
+}
+
 void Experiment::DoConfig__MAPElites() {
   std::cout << "Configure the strange world of MAP-Elites." << std::endl;
 
   world->SetCache(true);
-  world->SetAutoMutate();
-  // NOTE: i may need to set mutate on birth to be true!
-  world->SetFitFun([this](agent_t & agent) {
-    const size_t id = 0;
-    agent.SetID(id);
-    // Evaluate!
-    this->Evaluate(agent);
-    // Grab score
-    const double score = this->GetFitness(agent);
-    if (score > best_score) { best_score = score; dom_agent_id = id; }
-    return score;
-  });
+  if (MAP_ELITES_BATCH_EVAL) {
+    // Agents are evaluated in batches (see DoMAPElites__Batch); fitness is read from each
+    // agent's phenotype slot (its archive cell).
+    world->SetFitFun([this](agent_t & agent) { return this->GetFitness(agent); });
+  } else {
+    world->SetAutoMutate();
+    // NOTE: i may need to set mutate on birth to be true!
+    world->SetFitFun([this](agent_t & agent) {
+      const size_t id = 0;
+      agent.SetID(id);
+      // Evaluate! (MAP-Elites evaluates one agent at a time on the first worker)
+      this->Evaluate(*eval_workers[0], agent);
+      // Grab score
+      const double score = this->GetFitness(agent);
+      if (score > best_score) { best_score = score; dom_agent_id = id; }
+      return score;
+    });
+  }
 
-  emp::vector<size_t> trait_bin_sizes;
+  emp::vector<size_t> & trait_bin_sizes = mape_bin_sizes;
+  trait_bin_sizes.clear();
   if (MAP_ELITES_AXIS__INST_ENTROPY) {
     std::cout << "Configuring instruction entropy axis" << std::endl;
     world->AddPhenotype("InstEntropy", inst_ent_fun, 0.0, max_inst_entropy + 0.1);
@@ -1461,7 +2072,12 @@ void Experiment::DoConfig__MAPElites() {
   for (size_t i = 0; i < trait_bin_sizes.size(); ++i) max_pop_size *= trait_bin_sizes[i];
 
   std::cout << "Updated max world size: " << max_pop_size << std::endl;
-  phen_cache.Resize(max_pop_size, TRIAL_CNT);
+  // Phenotype storage is not allocated per cell:
+  //  - Serial MAP-Elites evaluates every agent in slot 0.
+  //  - Batched MAP-Elites evaluates offspring in slots [0, POP_SIZE), and gives archive agents
+  //    slots as they fill cells (see AcquireMAPSlot), so storage grows with occupied cells only.
+  phen_cache.Resize((MAP_ELITES_BATCH_EVAL) ? POP_SIZE : 1, TRIAL_CNT);
+  mape_free_slots.clear();
 
   emp::SetMapElites(*world, trait_bin_sizes);
 
@@ -1469,10 +2085,19 @@ void Experiment::DoConfig__MAPElites() {
     best_score = MIN_POSSIBLE_SCORE;
   });
   
-  do_selection_sig.AddAction([this]() {
-    emp::RandomSelect(*world, POP_SIZE);
-    std::cout << "Update: " << update << " Best score (from this update): " << best_score << std::endl;
-  });
+  if (MAP_ELITES_BATCH_EVAL) {
+    // Evaluate the initial archive (after population initialization).
+    do_begin_run_setup_sig.AddAction([this]() { this->SeedMAPArchive(); });
+    do_selection_sig.AddAction([this]() {
+      this->DoMAPElites__Batch();
+      std::cout << "Update: " << update << " Best score (from this update): " << best_score << std::endl;
+    });
+  } else {
+    do_selection_sig.AddAction([this]() {
+      emp::RandomSelect(*world, POP_SIZE);
+      std::cout << "Update: " << update << " Best score (from this update): " << best_score << std::endl;
+    });
+  }
 
   do_world_update_sig.AddAction([this]() {
     world->ClearCache();
@@ -1493,20 +2118,13 @@ void Experiment::DoConfig__Experiment() {
     return this->mutate_agent(agent, rnd);
   });
 
-  eval_hw->OnBeforeFuncCall([this](hardware_t & hw, size_t fID) {
-    functions_used.emplace(fID);
-  });
-  eval_hw->OnBeforeCoreSpawn([this](hardware_t & hw, size_t fID) {
-    functions_used.emplace(fID);
-  });
-
   // Configure score.
   //  - If tasks: 
   //  - else: 
   if (TASKS_ON) {
-    calc_score = [this](agent_t & agent) {
+    calc_score = [this](eval_worker_t & worker, agent_t & agent) {
       double score = 0;
-      phenotype_t & phen = phen_cache.Get(agent.GetID(), trial_id);
+      phenotype_t phen = phen_cache.Get(agent.GetID(), worker.trial_id);
       score += phen.GetUniqueTasksCompleted();
       score += phen.GetUniqueTasksCredited();
       if (phen.GetTimeAllTasksCredited()) {
@@ -1516,23 +2134,24 @@ void Experiment::DoConfig__Experiment() {
       return score;
     };
   } else {
-    calc_score = [this](agent_t & agent) {
-      return phen_cache.Get(agent.GetID(), trial_id).GetEnvMatchScore();
+    calc_score = [this](eval_worker_t & worker, agent_t & agent) {
+      return phen_cache.Get(agent.GetID(), worker.trial_id).GetEnvMatchScore();
     };
   }
 
   // Configure mutations
   if (EVOLVE_SIMILARITY_THRESH) {
     mutate_agent = [this](agent_t & agent, emp::Random & rnd) {
-      program_t & program = agent.GetProgram();
-      size_t mut_cnt = mutator.ApplyMutations(program, rnd);
+      size_t mut_cnt = mutator.ApplyMutations(agent.GetGenome().program, rnd);
+      if (mut_cnt) agent.GetGenome().UpdateDescriptors();
       mut_cnt += this->MutateSimilarityThresh(agent, rnd);
       return mut_cnt;
     };
   } else {
     mutate_agent = [this](agent_t & agent, emp::Random & rnd) {
-      program_t & program = agent.GetProgram();
-      return mutator.ApplyMutations(program, rnd);
+      const size_t mut_cnt = mutator.ApplyMutations(agent.GetGenome().program, rnd);
+      if (mut_cnt) agent.GetGenome().UpdateDescriptors();
+      return mut_cnt;
     };
   }
 
@@ -1563,7 +2182,10 @@ void Experiment::DoConfig__Experiment() {
 
   // - Do world update
   do_world_update_sig.AddAction([this]() {
-    if (update % POP_SNAPSHOT_INTERVAL == 0) do_pop_snapshot_sig.Trigger(update);
+    if (update % POP_SNAPSHOT_INTERVAL == 0) {
+      CopySnapshotPopulation();
+      do_pop_snapshot_sig.Trigger(update);
+    }
     world->Update(); 
   });
 
@@ -1571,11 +2193,7 @@ void Experiment::DoConfig__Experiment() {
   do_begin_run_setup_sig.AddAction([this]() {
     std::cout << "Doing initial run setup." << std::endl;
     // Setup phenotype task counts to match actual task counts.
-    for (size_t aID = 0; aID < max_pop_size; ++aID) {
-      for (size_t tID = 0; tID < TRIAL_CNT; ++tID) {
-        phen_cache.Get(aID, tID).SetTaskCnt(task_set.GetSize());
-      }
-    }
+    phen_cache.SetTaskCnt(task_set.GetSize());
     // Setup systematics/fitness tracking.
     // TODO: ask Emily about issue with setting up systematics file
     // auto & sys_file = world->SetupSystematicsFile("default_systematics", DATA_DIRECTORY + "systematics.csv");
@@ -1586,53 +2204,56 @@ void Experiment::DoConfig__Experiment() {
   });
 
   // - Begin agent eval signal
-  begin_agent_eval_sig.AddAction([this](agent_t & agent) {
-    eval_hw->SetProgram(agent.GetProgram());
+  begin_agent_eval_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
+    worker.eval_hw->SetProgram(agent.GetProgram());
+    worker.match_cache.Clear();
   });
 
   if (EVOLVE_SIMILARITY_THRESH) {
     // Set similarity threshold on eval hardware at beginning of evaluation.
-    begin_agent_eval_sig.AddAction([this](agent_t & agent) {
-      eval_hw->SetMinBindThresh(agent.GetSimilarityThreshold());
+    begin_agent_eval_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
+      worker.eval_hw->SetMinBindThresh(agent.GetSimilarityThreshold());
     });
   }
 
-  end_agent_eval_sig.AddAction([this](agent_t & agent) {
+  end_agent_eval_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
     phen_cache.SetRepresentativeEval(agent.GetID());
   });
 
   // - Begin trial info!
-  begin_agent_trial_sig.AddAction([this](agent_t & agent) {
+  begin_agent_trial_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
     // 1) reset environment state
-    env_state = (size_t)-1;
+    worker.env_state = (size_t)-1;
     // 2) Reset tasks. 
-    this->ResetTasks();
-    input_load_id = 0;
+    this->ResetTasks(worker);
+    worker.input_load_id = 0;
     // 3) Reset hardware.
-    functions_used.clear();
-    eval_hw->ResetHardware();
-    eval_hw->SetTrait(TRAIT_ID__STATE, -1);
+    worker.functions_used.Clear();
+    worker.eval_hw->ResetHardware();
+    worker.eval_hw->SetTrait(TRAIT_ID__STATE, -1);
+    worker.eval_hw->SetTrait(TRAIT_ID__WORKER, worker.worker_id);
     // 4) Reset phenotype
-    phen_cache.Get(agent.GetID(), trial_id).Reset();
+    phen_cache.Get(agent.GetID(), worker.trial_id).Reset();
     // For now, not spawning a core... 
   });
 
-  do_agent_trial_sig.AddAction([this](agent_t & agent) {
-    for (trial_time = 0; trial_time < EVAL_TIME; ++trial_time) {
+  do_agent_trial_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
+    for (worker.trial_time = 0; worker.trial_time < EVAL_TIME; ++worker.trial_time) {
       // 1) Advance environment.
-      do_env_advance_sig.Trigger();
+      do_env_advance_sig.Trigger(worker);
       // 2) Advance agent.
-      do_agent_advance_sig.Trigger(agent);
+      do_agent_advance_sig.Trigger(worker, agent);
     }
   });
   
-  end_agent_trial_sig.AddAction([this](agent_t & agent) {
+  end_agent_trial_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
     const size_t agent_id = agent.GetID();
-    phenotype_t & phen = phen_cache.Get(agent_id, trial_id);
+    taskset_t & task_set = worker.task_set;
+    phenotype_t phen = phen_cache.Get(agent_id, worker.trial_id);
     // Record everything that must be recorded post-trial
-    phen.SetFunctionsUsed(this->func_used_fun(agent));
-    phen.SetFunctionCnt(this->func_cnt_fun(agent));
-    phen.SetInstEntropy(this->inst_ent_fun(agent));
+    phen.SetFunctionsUsed(worker.functions_used.GetUsedCnt());
+    phen.SetFunctionCnt(agent.GetFunctionCnt());
+    phen.SetInstEntropy(agent.GetInstEntropy());
     phen.SetSimilarityThreshold(agent.GetSimilarityThreshold());
     phen.SetTimeAllTasksCredited(task_set.GetAllTasksCreditedTime());
     phen.SetUniqueTasksCompleted(task_set.GetUniqueTasksCompleted());
@@ -1643,64 +2264,63 @@ void Experiment::DoConfig__Experiment() {
       phen.SetCompleted(taskID, task_set.GetTask(taskID).GetCompletionCnt());
       phen.SetWastedCompletions(taskID, task_set.GetTask(taskID).GetWastedCompletionsCnt());
     }
-    phen.SetScore(calc_score(agent));
+    phen.SetScore(calc_score(worker, agent));
   });
 
-  do_agent_advance_sig.AddAction([this](agent_t & agent) {
+  do_agent_advance_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
     const size_t agent_id = agent.GetID();
-    eval_hw->SingleProcess();
-    if ((size_t)eval_hw->GetTrait(TRAIT_ID__STATE) == env_state) {
-      phen_cache.Get(agent_id, trial_id).IncEnvMatchScore();
+    worker.eval_hw->SingleProcess();
+    if ((size_t)worker.eval_hw->GetTrait(TRAIT_ID__STATE) == worker.env_state) {
+      phen_cache.Get(agent_id, worker.trial_id).IncEnvMatchScore();
     }
   });
 
   switch(ENVIRONMENT_CHANGE_METHOD) {
     case ENV_CHG_METHOD_ID__RANDOM: {
-      do_env_advance_sig.AddAction([this]() {
-        if (env_state == (size_t)-1 || random->P(ENVIRONMENT_CHANGE_PROB)) {
+      do_env_advance_sig.AddAction([this](eval_worker_t & worker) {
+        if (worker.env_state == (size_t)-1 || worker.random->P(ENVIRONMENT_CHANGE_PROB)) {
           // Trigger change!
           // 1) Change the environment to a random state.
-          env_state = random->GetUInt(ENVIRONMENT_STATES);
+          worker.env_state = worker.random->GetUInt(ENVIRONMENT_STATES);
           // 2) Trigger environment state event.
-          eval_hw->TriggerEvent("EnvSignal", env_state_tags[env_state]);
+          worker.eval_hw->TriggerEvent("EnvSignal", env_state_tags[worker.env_state]);
         }
       });
       break;
     }
     case ENV_CHG_METHOD_ID__SHUFFLED: {
-      do_env_advance_sig.AddAction([this]() {
-        if (env_state == (size_t)-1 || random->P(ENVIRONMENT_CHANGE_PROB)) {
+      do_env_advance_sig.AddAction([this](eval_worker_t & worker) {
+        if (worker.env_state == (size_t)-1 || worker.random->P(ENVIRONMENT_CHANGE_PROB)) {
           
           // What state should we switch to?
-          env_state = env_shuffler[env_shuffle_id]; 
-          env_shuffle_id += 1;
+          worker.env_state = worker.env_shuffler[worker.env_shuffle_id]; 
+          worker.env_shuffle_id += 1;
 
           // std::cout << "Environment changes to: " << env_state << std::endl;
 
           // If shuffle id exceeds env states, reset to 0 and shuffle!
-          if (env_shuffle_id >= ENVIRONMENT_STATES) {
-            env_shuffle_id = 0;
-            emp::Shuffle(*random, env_shuffler);
+          if (worker.env_shuffle_id >= ENVIRONMENT_STATES) {
+            worker.env_shuffle_id = 0;
+            emp::Shuffle(*worker.random, worker.env_shuffler);
             // std::cout << "---SHUFFLE TRIGGERED---" << std::endl;
           }
 
           // Trigger environment state event.
-          eval_hw->TriggerEvent("EnvSignal", env_state_tags[env_state]);
+          worker.eval_hw->TriggerEvent("EnvSignal", env_state_tags[worker.env_state]);
         }
       });
-      begin_agent_trial_sig.AddAction([this](agent_t & agent) {
-        env_shuffle_id = 0;
-        emp::Shuffle(*random, env_shuffler);
+      begin_agent_trial_sig.AddAction([this](eval_worker_t & worker, agent_t & agent) {
+        worker.ResetEnvShuffler();
       });
     }
     case ENV_CHG_METHOD_ID__REGULAR: {
-      do_env_advance_sig.AddAction([this]() {
-        if (env_state == (size_t)-1 || ((trial_time % ENVIRONMENT_CHANGE_INTERVAL) == 0)) {
+      do_env_advance_sig.AddAction([this](eval_worker_t & worker) {
+        if (worker.env_state == (size_t)-1 || ((worker.trial_time % ENVIRONMENT_CHANGE_INTERVAL) == 0)) {
           // Trigger change!
           // 1) Change the environment to a random state.
-          env_state = random->GetUInt(ENVIRONMENT_STATES);
+          worker.env_state = worker.random->GetUInt(ENVIRONMENT_STATES);
           // 2) Trigger environment state event.
-          eval_hw->TriggerEvent("EnvSignal", env_state_tags[env_state]);
+          worker.eval_hw->TriggerEvent("EnvSignal", env_state_tags[worker.env_state]);
         }
       });
       break;
@@ -1713,17 +2333,55 @@ void Experiment::DoConfig__Experiment() {
 
   // If distraction signals...
   if (ENVIRONMENT_DISTRACTION_SIGNALS) {
-    do_env_advance_sig.AddAction([this]() {
-      if (random->P(ENVIRONMENT_DISTRACTION_SIGNAL_PROB)) {
-        const size_t id = random->GetUInt(distraction_sig_tags.size());
-        eval_hw->TriggerEvent("EnvSignal", distraction_sig_tags[id]);
+    do_env_advance_sig.AddAction([this](eval_worker_t & worker) {
+      if (worker.random->P(ENVIRONMENT_DISTRACTION_SIGNAL_PROB)) {
+        const size_t id = worker.random->GetUInt(distraction_sig_tags.size());
+        worker.eval_hw->TriggerEvent("EnvSignal", distraction_sig_tags[id]);
       }
     });
   }
 }
 
 void Experiment::DoConfig__Analysis() {
-
+  switch (ANALYSIS_METHOD) {
+    case ANALYSIS_METHOD_ID__TEXT_TO_BINARY: {
+      // Convert a text program (.gp) or population (.pop) into a binary population file.
+      do_analysis_sig.AddAction([this]() {
+        std::ifstream text_fstream(ANALYZE_AGENT_FPATH);
+        if (!text_fstream.is_open()) {
+          std::cout << "Failed to open program file (" << ANALYZE_AGENT_FPATH << "). Exiting..." << std::endl;
+          exit(-1);
+        }
+        toolbelt::PopulationFileWriter<hardware_t> pop_writer(*inst_lib);
+        const size_t prog_cnt = toolbelt::LoadTextPopulation<hardware_t>(text_fstream, inst_lib, pop_writer);
+        if (!pop_writer.Write(ANALYSIS_OUTPUT_FNAME)) {
+          std::cout << "Failed to write " << ANALYSIS_OUTPUT_FNAME << ". Exiting..." << std::endl;
+          exit(-1);
+        }
+        std::cout << "Converted " << prog_cnt << " programs (" << ANALYZE_AGENT_FPATH << " => " << ANALYSIS_OUTPUT_FNAME << ")" << std::endl;
+      });
+      break;
+    }
+    case ANALYSIS_METHOD_ID__BINARY_TO_TEXT: {
+      // Convert a binary population file into a text population (.pop).
+      do_analysis_sig.AddAction([this]() {
+        toolbelt::PopulationFileView pop_file;
+        std::string error;
+        if (!pop_file.Open(ANALYZE_AGENT_FPATH, error) || !pop_file.IsCompatible<hardware_t>(*inst_lib, error)) {
+          std::cout << "Failed to load population file (" << error << "). Exiting..." << std::endl;
+          exit(-1);
+        }
+        std::ofstream text_fstream(ANALYSIS_OUTPUT_FNAME);
+        toolbelt::WriteTextPopulation<hardware_t>(pop_file, inst_lib, text_fstream);
+        std::cout << "Converted " << pop_file.GetProgramCnt() << " programs (" << ANALYZE_AGENT_FPATH << " => " << ANALYSIS_OUTPUT_FNAME << ")" << std::endl;
+      });
+      break;
+    }
+    default: {
+      std::cout << "Unrecognized analysis method (" << ANALYSIS_METHOD << "). Exiting..." << std::endl;
+      exit(-1);
+    }
+  }
 }
 
 #endif
@@ -7,6 +7,8 @@
 #include <functional>
 #include <map>
 #include <unordered_set>
+#include <cstdint>
+#include <type_traits>
 
 #include "base/Ptr.h"
 #include "base/vector.h"
@@ -18,6 +20,8 @@
 #include "tools/string_utils.h"
 #include "tools/map_utils.h"
 
+#include "../../utility_belt/source/Logic9.h"
+
 
 /// Task library for logic9 changing environment experiments.
 ///  - A library of tasks with common input/output types.
@@ -35,18 +39,42 @@ public:
     size_t id;
     std::string desc;
     emp::vector<task_output_t> solutions;
-    emp::vector<size_t> completed_time_stamps;
-    emp::vector<size_t> credited_time_stamps;
+    emp::vector<size_t> completed_time_stamps;  ///< Only recorded if task set is recording time stamps.
+    emp::vector<size_t> credited_time_stamps;   ///< Only recorded if task set is recording time stamps.
+    size_t completed_cnt;
+    size_t credited_cnt;
+    size_t first_completed_time;
+    size_t last_completed_time;
+    size_t first_credited_time;
+    size_t last_credited_time;
     size_t wasted_completions; ///< Completions *before* receiving credit.
     gen_sol_fun_t generate_solutions;
 
     Task(const std::string & _n, size_t _i, gen_sol_fun_t _gen_sols, const std::string & _d)
-      : name(_n), id(_i), desc(_d), wasted_completions(0), generate_solutions(_gen_sols)
+      : name(_n), id(_i), desc(_d), completed_cnt(0), credited_cnt(0),
+        first_completed_time(0), last_completed_time(0), first_credited_time(0), last_credited_time(0),
+        wasted_completions(0), generate_solutions(_gen_sols)
     { ; }
 
-    size_t GetCompletionCnt() const { return completed_time_stamps.size(); }
-    size_t GetCreditedCnt() const { return credited_time_stamps.size(); }
+    size_t GetCompletionCnt() const { return completed_cnt; }
+    size_t GetCreditedCnt() const { return credited_cnt; }
     size_t GetWastedCompletionsCnt() const { return wasted_completions; }
+    size_t GetFirstCompletedTime() const { return first_completed_time; }
+    size_t GetLastCompletedTime() const { return last_completed_time; }
+    size_t GetFirstCreditedTime() const { return first_credited_time; }
+    size_t GetLastCreditedTime() const { return last_credited_time; }
+
+    void ResetRecords() {
+      completed_time_stamps.resize(0);
+      credited_time_stamps.resize(0);
+      completed_cnt = 0;
+      credited_cnt = 0;
+      first_completed_time = 0;
+      last_completed_time = 0;
+      first_credited_time = 0;
+      last_credited_time = 0;
+      wasted_completions = 0;
+    }
   };
 
 protected:
@@ -65,7 +93,70 @@ protected:
   // task_input_t task_inputs;
 
   bool sollision;
-  std::unordered_set<task_output_t> solution_set; ///< Used for detecting collisions between solutions.
+  bool record_time_stamps;  ///< Keep full completion/credit time stamp history? (otherwise, counts + first/last)
+
+  // Solution index: small open-addressing table mapping solution => task ID (built by SetInputs).
+  // Also used to detect collisions between solutions.
+  emp::vector<task_output_t> index_sols;
+  emp::vector<size_t> index_tasks;   ///< Task ID for each slot (NO_TASK if slot is empty).
+  size_t index_mask;
+
+  // Logic tasks (see AddLogicTask). If every task is a logic task, SetInputs skips the per-task
+  // solution generators and computes all solutions with one LogicBattery call.
+  toolbelt::LogicBattery logic_battery;
+  emp::vector<size_t> logic_offsets;          ///< Logic task i's ops are [logic_offsets[i], logic_offsets[i+1]).
+  emp::vector<task_output_t> logic_sols;
+
+  static constexpr size_t NO_TASK = (size_t)-1;
+
+  size_t GetIndexSlot(const task_output_t & sol) const {
+    // Fibonacci hashing spreads nearby values (task outputs are bitwise functions of the inputs).
+    return (size_t)(((uint64_t)std::hash<task_output_t>()(sol) * 11400714819323198485ull) >> 32) & index_mask;
+  }
+
+  /// Find task ID for given solution (NO_TASK if sol is not a solution).
+  size_t FindTaskID(const task_output_t & sol) const {
+    size_t slot = GetIndexSlot(sol);
+    while (index_tasks[slot] != NO_TASK) {
+      if (index_sols[slot] == sol) return index_tasks[slot];
+      slot = (slot + 1) & index_mask;
+    }
+    return NO_TASK;
+  }
+
+  /// Add solution to index. Returns false if solution is already in the index (i.e., a collision).
+  bool IndexSolution(const task_output_t & sol, size_t task_id) {
+    size_t slot = GetIndexSlot(sol);
+    while (index_tasks[slot] != NO_TASK) {
+      if (index_sols[slot] == sol) return false;
+      slot = (slot + 1) & index_mask;
+    }
+    index_sols[slot] = sol;
+    index_tasks[slot] = task_id;
+    return true;
+  }
+
+  /// Record a completion of given task.
+  void CompleteTask(Task & task, size_t timestamp, bool credit) {
+    if (record_time_stamps) task.completed_time_stamps.emplace_back(timestamp);
+    if (!task.completed_cnt) task.first_completed_time = timestamp;
+    task.last_completed_time = timestamp;
+    task.completed_cnt++;
+    if (task.GetCompletionCnt() == 1) unique_tasks_completed++;
+    total_tasks_completed++;
+    if (credit) {
+      if (record_time_stamps) task.credited_time_stamps.emplace_back(timestamp);
+      if (!task.credited_cnt) task.first_credited_time = timestamp;
+      task.last_credited_time = timestamp;
+      task.credited_cnt++;
+      if (task.GetCreditedCnt() == 1) unique_tasks_credited++;
+      total_tasks_credited++;
+    } else if (!task.GetCreditedCnt()) {
+      // If you did it, but didn't get credit, increment wasted completions (total and task)
+      task.wasted_completions++;
+      total_tasks_wasted++;
+    }
+  }
 
 
 public:
@@ -79,7 +170,14 @@ public:
       time_all_tasks_completed(0),
       all_tasks_credited(false),
       all_tasks_completed(false),
-      sollision(false)
+      sollision(false),
+      record_time_stamps(true),
+      index_sols(),
+      index_tasks(),
+      index_mask(0),
+      logic_battery(),
+      logic_offsets(1, 0),
+      logic_sols()
     { ; }
   ~TaskSet() { ; }
 
@@ -104,6 +202,11 @@ public:
   bool AllTasksCredited() const { return all_tasks_credited; }
   bool AllTasksCompleted() const { return all_tasks_completed; }
 
+  bool GetRecordTimeStamps() const { return record_time_stamps; }
+  /// Should we keep full completion/credit time stamp vectors? If not, tasks only track counts
+  /// and first/last times.
+  void SetRecordTimeStamps(bool record) { record_time_stamps = record; }
+
   bool IsTask(const std::string name) const { return emp::Has(name_map, name); }
 
   void AddTask(const std::string & name,
@@ -115,6 +218,27 @@ public:
     name_map[name] = id;
   }
 
+  /// Add a task whose solutions are bitwise logic functions of the first two inputs (one solution
+  /// per op). Requires 32-bit task outputs.
+  void AddLogicTask(const std::string & name,
+                    const emp::vector<toolbelt::logic_op_t> & ops,
+                    const std::string & desc = "")
+  {
+    static_assert(std::is_same<task_output_t, uint32_t>::value, "Logic tasks require uint32_t task outputs.");
+    AddTask(name, [ops](Task & task, const task_input_t & inputs) {
+      for (toolbelt::logic_op_t op : ops) task.solutions.emplace_back(toolbelt::ApplyLogicOp(op, inputs[0], inputs[1]));
+    }, desc);
+    for (toolbelt::logic_op_t op : ops) logic_battery.AddOp(op);
+    logic_offsets.emplace_back(logic_battery.GetSize());
+  }
+
+  void AddLogicTask(const toolbelt::Logic9Task & task) {
+    AddLogicTask(task.name, emp::vector<toolbelt::logic_op_t>(task.ops, task.ops + task.op_cnt), task.desc);
+  }
+
+  /// Are all tasks logic tasks?
+  bool IsLogicOnly() const { return task_lib.size() && logic_offsets.size() == task_lib.size() + 1; }
+
   /// Reset tasks without changing inputs.
   void Reset() {
     unique_tasks_credited = 0;
@@ -127,9 +251,7 @@ public:
     all_tasks_credited = false;
     all_tasks_completed = false;
     for (size_t i = 0; i < task_lib.size(); ++i) {
-      task_lib[i].completed_time_stamps.resize(0);
-      task_lib[i].credited_time_stamps.resize(0);
-      task_lib[i].wasted_completions = 0;
+      task_lib[i].ResetRecords();
     }
   }
 
@@ -138,18 +260,47 @@ public:
 
   /// Set inputs. Reset everything.
   void SetInputs(const task_input_t & inputs) {
-    sollision = false;
-    solution_set.clear();
+    if (IsLogicOnly()) {
+      logic_sols.resize(logic_battery.GetSize());
+      logic_battery.Solve(inputs[0], inputs[1], logic_sols.data());
+      SetSolutions(logic_sols.data(), logic_offsets);
+      return;
+    }
     Reset();
     for (size_t i = 0; i < task_lib.size(); ++i) {
       task_lib[i].solutions.resize(0);
       task_lib[i].generate_solutions(task_lib[i], inputs);
+    }
+    BuildIndex();
+  }
+
+  /// Set solutions directly (e.g., precomputed for some inputs) rather than generating them from
+  /// inputs. Solutions are laid out task by task; task i's solutions are
+  /// [sols + offsets[i], sols + offsets[i+1]). Reset everything.
+  void SetSolutions(const task_output_t * sols, const emp::vector<size_t> & offsets) {
+    emp_assert(offsets.size() == task_lib.size() + 1);
+    Reset();
+    for (size_t i = 0; i < task_lib.size(); ++i) {
+      task_lib[i].solutions.assign(sols + offsets[i], sols + offsets[i+1]);
+    }
+    BuildIndex();
+  }
+
+  /// Rebuild solution index (and collision flag) from tasks' current solutions.
+  void BuildIndex() {
+    sollision = false;
+    size_t sol_cnt = 0;
+    for (size_t i = 0; i < task_lib.size(); ++i) sol_cnt += task_lib[i].solutions.size();
+    // Size index to keep load factor <= 1/2.
+    size_t index_size = 8;
+    while (index_size < 2 * sol_cnt) index_size <<= 1;
+    index_sols.resize(index_size);
+    index_tasks.resize(index_size);
+    std::fill(index_tasks.begin(), index_tasks.end(), NO_TASK);
+    index_mask = index_size - 1;
+    for (size_t i = 0; i < task_lib.size(); ++i) {
       for (size_t s = 0; s < task_lib[i].solutions.size(); ++s) {
-        if (emp::Has(solution_set, task_lib[i].solutions[s])) {
-          sollision = true;
-        } else {
-          solution_set.emplace(task_lib[i].solutions[s]);
-        }
+        if (!IndexSolution(task_lib[i].solutions[s], i)) sollision = true;
       }
     }
   }
@@ -157,24 +308,23 @@ public:
   /// Submit possible solution, checking against all tasks.
   /// If submission is indeed a solution, record information about task completion.
   /// Return whether or not submitted solution was a solution.
+  /// Without collisions, every solution belongs to exactly one task, so a single index probe finds
+  /// it. With collisions (a solution shared by several tasks), fall back to checking every task.
   bool Submit(const task_output_t & sol, size_t timestamp=0, bool credit=true) {
     bool success = false;
-    for (size_t i = 0; i < task_lib.size(); ++i) {
-      Task & task = task_lib[i];
-      for (size_t s = 0; s < task.solutions.size(); ++s) {
-        if (task.solutions[s] == sol) {
-          success = true;
-          task.completed_time_stamps.emplace_back(timestamp);
-          if (task.GetCompletionCnt() == 1) unique_tasks_completed++;
-          total_tasks_completed++;
-          if (credit) {
-            task.credited_time_stamps.emplace_back(timestamp);
-            if (task.GetCreditedCnt() == 1) unique_tasks_credited++;
-            total_tasks_credited++;
-          } else if (!task.GetCreditedCnt()) {
-            // If you did it, but didn't get credit, increment wasted completions (total and task)
-            task.wasted_completions++;
-            total_tasks_wasted++;
+    if (!sollision) {
+      const size_t task_id = FindTaskID(sol);
+      if (task_id != NO_TASK) {
+        success = true;
+        CompleteTask(task_lib[task_id], timestamp, credit);
+      }
+    } else {
+      for (size_t i = 0; i < task_lib.size(); ++i) {
+        Task & task = task_lib[i];
+        for (size_t s = 0; s < task.solutions.size(); ++s) {
+          if (task.solutions[s] == sol) {
+            success = true;
+            CompleteTask(task, timestamp, credit);
           }
         }
       }
@@ -192,4 +342,7 @@ public:
 
 };
 
+template<typename INPUT_T, typename OUTPUT_T>
+constexpr size_t TaskSet<INPUT_T, OUTPUT_T>::NO_TASK;
+
 #endif
@@ -5,17 +5,22 @@
 // TODO: Update configs (both what's in here and the descriptions)!
 EMP_BUILD_CONFIG( L9ChgEnvConfig,
   GROUP(DEFAULT_GROUP, "General Settings"),
-  VALUE(RUN_MODE, size_t, 0, "What mode are we running in? \n0: Native experiment\n1: Analyze mode"),
+  VALUE(RUN_MODE, size_t, 0, "What mode are we running in? \n0: Evolution (generational)\n1: MAP-Elites\n2: Analysis\n3: Steady-state evolution"),
   VALUE(RANDOM_SEED, int, -1, "Random number seed (negative value for based on time)"),
   VALUE(POP_SIZE, size_t, 1000, "Total population size"),
   VALUE(GENERATIONS, size_t, 100, "How many generations should we run evolution?"),
   VALUE(POP_INIT_METHOD, size_t, 0, "..."),
-  VALUE(ANCESTOR_FPATH, std::string, "ancestor.gp", "Ancestor program file"),
+  VALUE(ANCESTOR_FPATH, std::string, "ancestor.gp", "Ancestor program file (or binary population file to seed the population with)"),
   GROUP(EVALUATION_GROUP, "Evaluation Settings"),
   VALUE(EVAL_TIME, size_t, 256, "Agent evaluation time"),
   VALUE(TRIAL_CNT, size_t, 3, "..."),
   VALUE(TASKS_ON, bool, true, "Run with or without tasks?"),
+  VALUE(TASK_INPUT_POOL_SIZE, size_t, 0, "Draw task inputs from a pool of this many precomputed collision-free inputs (0 to generate inputs on the fly every trial)"),
+  VALUE(RECORD_TASK_TIME_STAMPS, bool, false, "Keep full task completion/credit time stamp history? (otherwise, only counts and first/last times are kept)"),
+  VALUE(RECORD_FUNCTION_CALL_COUNTS, bool, false, "Count calls/spawns per function during evaluation? (written out with dominant snapshots)"),
   VALUE(EVOLVE_SIMILARITY_THRESH, bool, false, "Are we evolving the min required similarity threshold?"),
+  VALUE(EVAL_THREAD_CNT, size_t, 1, "How many threads should we use to evaluate the population? (results do not depend on thread count)"),
+  VALUE(EVAL_GENOTYPE_CACHE, bool, true, "Evaluate each unique genotype only once per generation? (copies reuse phenotype of first copy evaluated)"),
   GROUP(ENVIRONMENT_GROUP, "Environment Settings"),
   VALUE(ENVIRONMENT_STATES, size_t, 8, "Total possible number of environment states"),
   VALUE(ENVIRONMENT_TAG_GENERATION_METHOD, size_t, 0, "How should we generate environment tags?\n0: Randomly\n1: Load from file"),
@@ -30,6 +35,9 @@ EMP_BUILD_CONFIG( L9ChgEnvConfig,
   VALUE(TOURNAMENT_SIZE, size_t, 4, "How big are tournaments when using tournament selection or any selection method that uses tournaments?"),
   VALUE(SELECTION_METHOD, size_t, 0, "Which selection method are we using? \n0: Tournament\n1: Lexicase\n2: Eco-EA (resource)\n3: MAP-Elites\n4: Roulette"),
   VALUE(ELITE_SELECT__ELITE_CNT, size_t, 1, "How many elites get free reproduction passes?"),
+  VALUE(STEADY_STATE_UPDATE_BIRTHS, size_t, 0, "Steady-state evolution: births per update (GENERATIONS and data/snapshot intervals count updates); 0 for POP_SIZE"),
+  VALUE(PARALLEL_SELECTION, bool, false, "Should tournament/elite selection and mutation run on per-(generation, slot) random number streams across EVAL_THREAD_CNT threads? (results do not depend on thread count, but differ from serial selection)"),
+  VALUE(MAP_ELITES_BATCH_EVAL, bool, false, "Should MAP-Elites generate each update's POP_SIZE offspring as a batch, evaluate them across EVAL_THREAD_CNT threads, and then insert them into the archive in order? (results do not depend on thread count, but differ from serial MAP-Elites)"),
   VALUE(MAP_ELITES_AXIS__INST_ENTROPY, bool, true, "Should MAP-Elites use instruction entropy as an axis?"),
   VALUE(MAP_ELITES_AXIS__FUNCTIONS_USED, bool, true, "Should MAP-Elites use functions used as an axis?"),
   VALUE(MAP_ELITES_AXIS__FUNCTION_CNT, bool, true, "Should MAP-Elites use an agent's function count as an axis?"),
@@ -63,10 +71,11 @@ EMP_BUILD_CONFIG( L9ChgEnvConfig,
   VALUE(SYSTEMATICS_INTERVAL, size_t, 100, "Interval to record systematics summary stats."),
   VALUE(FITNESS_INTERVAL, size_t, 100, "Interval to record fitness summary stats."),
   VALUE(POP_SNAPSHOT_INTERVAL, size_t, 10000, "Interval to take a full snapshot of the population."),
+  VALUE(POP_SNAPSHOT_FORMAT, size_t, 0, "Population snapshot file format? \n0: Text (.pop)\n1: Binary (.bpop)\n2: Both"),
   VALUE(DOM_SNAPSHOT_TRIAL_CNT, size_t, 100, "How many times should we evaluate dominant agent?"),
   VALUE(DATA_DIRECTORY, std::string, "./", "Location to dump data output."),
   GROUP(ANALYSIS_GROUP, "Analysis Settings"),
-  VALUE(ANALYSIS_METHOD, size_t, 0, "..."),
+  VALUE(ANALYSIS_METHOD, size_t, 0, "Which analysis should we run? \n1: Convert text program/population (ANALYZE_AGENT_FPATH) to binary population file (ANALYSIS_OUTPUT_FNAME)\n2: Convert binary population file (ANALYZE_AGENT_FPATH) to text population (ANALYSIS_OUTPUT_FNAME)"),
   VALUE(ANALYZE_AGENT_FPATH, std::string, "ancestor.gp", "Path to single agent program to analzye."),
   VALUE(ANALYSIS_OUTPUT_FNAME, std::string, "analysis.csv", "...")
 )
@@ -26,6 +26,7 @@
 #include "tools/string_utils.h"
 
 #include "../../utility_belt/source/utilities.h"
+#include "../../utility_belt/source/InstructionSets.h"
 
 #include "t_maze-config.h"
 #include "TMaze.h"
@@ -83,6 +84,7 @@ public:
   using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
   using state_t = hardware_t::State;
   using program_t = hardware_t::Program;
+  using program_pool_t = toolbelt::ObjectPool<program_t>;
   using function_t = hardware_t::Function;
   using inst_t = hardware_t::inst_t;
   using inst_lib_t = hardware_t::inst_lib_t;
@@ -102,16 +104,18 @@ public:
   /// Agent to be evolved. 
   struct Agent {
     size_t agent_id;
-    program_t program;
+    toolbelt::Pooled<program_t> program;   ///< Recycled through the experiment's program pool.
 
-    Agent(const program_t & _p) : agent_id(0), program(_p) { ; }
-    Agent(const Agent && in) : agent_id(in.GetID()), program(in.program) { ; }
-    Agent(const Agent & in): agent_id(in.GetID()), program(in.program) { ; }
+    Agent(const program_t & _p, emp::Ptr<program_pool_t> pool=nullptr) : agent_id(0), program(_p, pool) { ; }
+    Agent(const Agent & in) = default;
+    Agent(Agent && in) noexcept = default;
+    Agent & operator=(const Agent & in) = default;
+    Agent & operator=(Agent && in) noexcept = default;
 
     size_t GetID() const { return agent_id; }
     void SetID(size_t id) { agent_id = id; }
 
-    program_t & GetGenome() { return program; }
+    program_t & GetGenome() { return program.Get(); }
 
   };
 
@@ -226,6 +230,13 @@ public:
         return agent_representative_eval[agent_id];
       }
 
+      /// Copy all cached evaluations (and representative) of one agent to another.
+      void CopyAgent(size_t from_id, size_t to_id) {
+        emp_assert(from_id < agent_cnt && to_id < agent_cnt);
+        for (size_t eID = 0; eID < eval_cnt; ++eID) Get(to_id, eID) = Get(from_id, eID);
+        agent_representative_eval[to_id] = agent_representative_eval[from_id];
+      }
+
       phenotype_t & GetRepresentative(size_t agent_id) {
         return Get(agent_id, agent_representative_eval[agent_id]);
       }
@@ -261,6 +272,7 @@ protected:
   size_t ELITE_SELECT__ELITE_CNT;
  // - Evaluation group
   size_t EVALUATION_CNT;
+  bool EVAL_GENOTYPE_CACHE;
   size_t MAZE_TRIAL_CNT;
   size_t REWARD_SWITCH_TRIAL_MIN; 
   size_t REWARD_SWITCH_TRIAL_MAX; 
@@ -315,11 +327,15 @@ protected:
   // Experiment variables
   emp::Ptr<emp::Random> random;     ///< Random number generator
   emp::Ptr<world_t> world;          ///< Empirical world for evolution
+  program_pool_t program_pool;      ///< Recycled program storage for agents
 
   emp::Ptr<inst_lib_t> inst_lib;    ///< SignalGP instruction library
   emp::Ptr<event_lib_t> event_lib;  ///< SignalGP event library
 
+  emp::Ptr<emp::Random> eval_random;     ///< Random number generator used during evaluation
+  toolbelt::RandomStreams eval_streams;  ///< Per-(generation, agent, evaluation) random number streams
   emp::Ptr<hardware_t> eval_hw;     ///< SignalGP virtual hardware used for evaluation
+  toolbelt::TagMatchCache<hardware_t> match_cache; ///< Memoized tag lookups for program on eval_hw
 
   size_t update;    ///< Current update (generation) of experiment
   size_t eval_id;   ///< Current trial of current evaluation. (only meaningful during an agent evaluation)
@@ -342,6 +358,11 @@ protected:
   // std::unordered_map<TMaze::CellType, tag_t> maze_tags;
   emp::vector<tag_t> maze_tags;
 
+  // MazeLocation event messages are kept around rather than built in a temporary map per event.
+  // Note: TriggerEvent still copies the message into the event it queues.
+  memory_t start_event_mem;   ///< Message for trial-start MazeLocation event (constant).
+  memory_t action_event_mem;  ///< Message for after-action MazeLocation events (value rewritten per event).
+
   // Run signals
   emp::Signal<void(void)> do_begin_run_setup_sig;   ///< Triggered at begining of run.
   emp::Signal<void(void)> do_pop_init_sig;          ///< Triggered during run setup. Defines way population is initialized.
@@ -368,7 +389,10 @@ protected:
   emp::Signal<void(agent_t &)> after_agent_action_sig; ///< Triggered after agent performs action
 
   void Evaluate(agent_t & agent) {
+    const size_t genotype_hash = toolbelt::HashProgram(agent.GetGenome());
     for (eval_id = 0; eval_id < EVALUATION_CNT; ++eval_id) {
+      // Each evaluation gets its own random number stream (identical genotypes get identical streams).
+      eval_streams.SeedStream(*eval_random, update, genotype_hash, eval_id);
       begin_agent_eval_sig.Trigger(agent);
       for (maze_trial_id = 0; maze_trial_id < MAZE_TRIAL_CNT; ++maze_trial_id) {
         if (maze_trial_id == switch_trial_by_eval[eval_id]) { 
@@ -418,6 +442,7 @@ protected:
   
     eval_hw->SetProgram(test_prog);
     eval_hw->ResetHardware();
+    match_cache.Clear();
 
     begin_agent_eval_sig.Trigger(test_hero);
     size_t switch_clock = 0;
@@ -460,7 +485,7 @@ public:
       trial_time(0), trial_step(0), 
       // done_step(false), done_trial(false),
       dom_agent_id(0), phen_cache(0, 0),
-      maze(), maze_tags(0)
+      maze(), maze_tags(0), start_event_mem(), action_event_mem()
   { 
     // Load configuration parameters. 
     // - General parameters
@@ -475,6 +500,7 @@ public:
     ELITE_SELECT__ELITE_CNT = config.ELITE_SELECT__ELITE_CNT();
     // - Evaluation parameters
     EVALUATION_CNT = config.EVALUATION_CNT();
+    EVAL_GENOTYPE_CACHE = config.EVAL_GENOTYPE_CACHE();
     MAZE_TRIAL_EXECUTION_METHOD = config.MAZE_TRIAL_EXECUTION_METHOD();
     MAZE_TRIAL_CNT = config.MAZE_TRIAL_CNT();
     REWARD_SWITCH_TRIAL_MIN = config.REWARD_SWITCH_TRIAL_MIN();
@@ -548,6 +574,9 @@ public:
     maze.SetLargeRewardValue(MAZE_LARGE_REWARD_VALUE);
     maze.SetSmallRewardValue(MAZE_SMALL_REWARD_VALUE);
     maze.SetBaseValue(0.0);
+    // The trial-start MazeLocation message never changes.
+    start_event_mem[EVENT_DATA_ID__VALUE] = 0;
+    start_event_mem[EVENT_DATA_ID__PENALTY_FB] = 0;
 
     // Configure maze tags
     switch (MAZE_CELL_TAG_GENERATION_METHOD) {
@@ -576,7 +605,9 @@ public:
     // Make empty instruction/event libraries
     inst_lib = emp::NewPtr<inst_lib_t>();
     event_lib = emp::NewPtr<event_lib_t>();
-    eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, random);
+    eval_random = emp::NewPtr<emp::Random>((int)random->GetUInt(1, 2147483647));
+    eval_streams.SetBaseSeed(random->GetUInt());
+    eval_hw = emp::NewPtr<hardware_t>(inst_lib, event_lib, eval_random);
 
     // Configure hardware and instruction/event libraries.
     DoConfig__Hardware();
@@ -597,6 +628,7 @@ public:
 
   ~Experiment() {
     eval_hw.Delete();
+    eval_random.Delete();
     event_lib.Delete();
     inst_lib.Delete();
     world.Delete();
@@ -641,7 +673,6 @@ public:
   // -- Execution control instructions --
   static void Inst_Call(hardware_t & hw, const inst_t & inst);      
   static void Inst_Fork(hardware_t & hw, const inst_t & inst);      
-  static void Inst_Terminate(hardware_t & hw, const inst_t & inst); 
   // -- Movement instructions --
   void Inst_Forward(hardware_t & hw, const inst_t & inst);
   void Inst_RotCW(hardware_t & hw, const inst_t & inst);
@@ -673,12 +704,6 @@ void Experiment::Inst_Fork(hardware_t & hw, const inst_t & inst) {
   hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem, false, true);
 }
 
-void Experiment::Inst_Terminate(hardware_t & hw, const inst_t & inst)  {
-  // Pop all the call states from current core.
-  exec_stk_t & core = hw.GetCurCore();
-  core.resize(0);
-}
-
 void Experiment::Inst_RotCW(hardware_t & hw, const inst_t & inst) {
   if (hw.GetTrait(TRAIT_ID__LAST_ACTION)) return; // Not allowed to do two actions per time step.
   hw.SetTrait(TRAIT_ID__FACING, emp::Mod(hw.GetTrait(TRAIT_ID__FACING) + 1, TMaze::NUM_DIRECTIONS));
@@ -799,7 +824,7 @@ void Experiment::InitPopulation__FromAncestorFile() {
   std::cout << " --- Ancestor program: ---" << std::endl;
   ancestor_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
-  world->Inject(ancestor_prog, POP_SIZE);    // Inject population!
+  world->Inject(agent_t(ancestor_prog, &program_pool), POP_SIZE);    // Inject population!
 }
 
 void Experiment::GenerateMazeTags__FromTagFile() {
@@ -851,7 +876,7 @@ void Experiment::Snapshot__Programs(size_t u) {
     if (!world->IsOccupied(i)) continue;
     prog_ofstream << "==="<<i<<":"<<world->CalcFitnessID(i)<<"===\n";
     Agent & agent = world->GetOrg(i);
-    agent.program.PrintProgramFull(prog_ofstream);
+    agent.GetGenome().PrintProgramFull(prog_ofstream);
   }
   prog_ofstream.close();
 }
@@ -1128,35 +1153,11 @@ double Experiment::CalcFitness(agent_t & agent) {
 void Experiment::DoConfig__Hardware() {
   // Setup the instruction set
   // - Standard instructions:
-  inst_lib->AddInst("Inc", hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
-  inst_lib->AddInst("Dec", hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
-  inst_lib->AddInst("Not", hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
-  inst_lib->AddInst("Add", hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
-  inst_lib->AddInst("Sub", hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
-  inst_lib->AddInst("Mult", hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
-  inst_lib->AddInst("Div", hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
-  inst_lib->AddInst("Mod", hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
-  inst_lib->AddInst("TestEqu", hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
-  inst_lib->AddInst("TestNEqu", hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
-  inst_lib->AddInst("TestLess", hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
-  inst_lib->AddInst("If", hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("While", hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Countdown", hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
-  inst_lib->AddInst("Close", hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
-  inst_lib->AddInst("Break", hardware_t::Inst_Break, 0, "Break out of current block.");
-  inst_lib->AddInst("Return", hardware_t::Inst_Return, 0, "Return from current function if possible.");
-  inst_lib->AddInst("SetMem", hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
-  inst_lib->AddInst("CopyMem", hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
-  inst_lib->AddInst("SwapMem", hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
-  inst_lib->AddInst("Input", hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
-  inst_lib->AddInst("Output", hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
-  inst_lib->AddInst("Commit", hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Pull", hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
-  inst_lib->AddInst("Nop", hardware_t::Inst_Nop, 0, "No operation.");
+  toolbelt::AddStandardInstructions<hardware_t>(*inst_lib);
   
   inst_lib->AddInst("Call", Inst_Call, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
   inst_lib->AddInst("Fork", Inst_Fork, 0, "Fork a new thread. Local memory contents of callee are loaded into forked thread's input memory.", emp::ScopeType::BASIC, 0, {"affinity"});
-  inst_lib->AddInst("Terminate", Inst_Terminate, 0, "Kill current thread.");
+  inst_lib->AddInst("Terminate", toolbelt::Inst_Terminate<hardware_t>, 0, "Kill current thread.");
 
   // Actuation instructions
   // - Forward
@@ -1209,57 +1210,13 @@ void Experiment::DoConfig__Hardware() {
   switch(REF_MOD_ADJUSTMENT_TYPE) {
     case REF_MOD_ADJUSTMENT_TYPE_ID__ADD: {
       // When applying regulation to a function's reference modifier, do so by adding/subtracting ref mod adjustment value.
-
-      inst_lib->AddInst("Promote", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod + REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Up regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
-      inst_lib->AddInst("Repress", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod - REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Down regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
+      toolbelt::AddRegulationInstructions<hardware_t>(*inst_lib, match_cache, REF_MOD_ADJUSTMENT_VALUE, false, MODIFY_REG);
       break;
     }
     case REF_MOD_ADJUSTMENT_TYPE_ID__MULT: {
 
       emp_assert(REF_MOD_ADJUSTMENT_VALUE != 0);
-
-      inst_lib->AddInst("Promote", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod * REF_MOD_ADJUSTMENT_VALUE);
-      }, 0, "Up regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-
-      inst_lib->AddInst("Repress", [this](hardware_t & hw, const inst_t & inst) {
-        emp::vector<size_t> targets(hw.FindBestFuncMatch(inst.affinity, 0.0, MODIFY_REG));
-        size_t targetID;
-        if (targets.empty()) return; 
-        if (targets.size() == 1) targetID = targets[0];
-        else targetID = targets[random->GetUInt(targets.size())];
-        program_t & program = hw.GetProgram();
-        double cur_mod = program[targetID].GetRefModifier();
-        program[targetID].SetRefModifier(cur_mod * (1/REF_MOD_ADJUSTMENT_VALUE));
-      }, 0, "Down regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
-      
+      toolbelt::AddRegulationInstructions<hardware_t>(*inst_lib, match_cache, REF_MOD_ADJUSTMENT_VALUE, true, MODIFY_REG);
       break;
     }
     default: {
@@ -1345,16 +1302,29 @@ void Experiment::DoConfig__Experiment() {
       switch_trial_by_eval[eID] = random->GetUInt(REWARD_SWITCH_TRIAL_MIN, REWARD_SWITCH_TRIAL_MAX);
     }
     
+    // Each unique genotype is evaluated once; copies reuse the first copy's phenotypes.
+    toolbelt::GenotypeIndex genotypes;
+    auto same_genotype = [this](size_t a, size_t b) {
+      return toolbelt::SameProgram(world->GetOrg(a).GetGenome(), world->GetOrg(b).GetGenome());
+    };
     for (size_t id = 0; id < world->GetSize(); ++id) {
       // Load and configure agent
       agent_t & our_hero = world->GetOrg(id);
       our_hero.SetID(id);
-      // Take care of one-time stuff for this evaluation.
-      eval_hw->SetProgram(our_hero.GetGenome());
-      // Evaluate!
-      this->Evaluate(our_hero);
-      // Find representative evaluation (the mininum)
-      phen_cache.SetRepresentativeEval(id);
+      bool cached = false;
+      if (EVAL_GENOTYPE_CACHE) {
+        const size_t eval_id = genotypes.FindOrAdd(toolbelt::HashProgram(our_hero.GetGenome()), id, same_genotype);
+        if (eval_id != id) { phen_cache.CopyAgent(eval_id, id); cached = true; }
+      }
+      if (!cached) {
+        // Take care of one-time stuff for this evaluation.
+        eval_hw->SetProgram(our_hero.GetGenome());
+        match_cache.Clear();
+        // Evaluate!
+        this->Evaluate(our_hero);
+        // Find representative evaluation (the mininum)
+        phen_cache.SetRepresentativeEval(id);
+      }
       // Grab score
       double score = CalcFitness(our_hero);
       if (score > best_score) { best_score = score; dom_agent_id = id; }
@@ -1375,8 +1345,9 @@ void Experiment::DoConfig__Experiment() {
   begin_agent_eval_sig.AddAction([this](agent_t & agent) {
     // Reset hardware (hard, complete reset)
     eval_hw->ResetHardware();
+    match_cache.InvalidateRegulated();
     // Reset the maze 
-    maze.RandomizeRewards(*random);
+    maze.RandomizeRewards(*eval_random);
     // Reset phenotype.
     const size_t agentID = agent.GetID();
     phenotype_t & phen = phen_cache.Get(agentID, eval_id);
@@ -1392,6 +1363,7 @@ void Experiment::DoConfig__Experiment() {
     //  - Do we wipe shared memory between trials? 
     //  - Do we reset function reference modifiers between trials?
     eval_hw->ResetHardware(AFTER_MAZE_TRIAL__WIPE_SHARED_MEM, AFTER_MAZE_TRIAL__CLEAR_FUNC_REF_MODS);
+    if (AFTER_MAZE_TRIAL__CLEAR_FUNC_REF_MODS) match_cache.InvalidateRegulated();
 
     // TMaze::Cell & start_cell = maze.GetCell(maze.GetStartCellID());
 
@@ -1407,10 +1379,7 @@ void Experiment::DoConfig__Experiment() {
         
     // Trigger START signal
     maze_location_sig.Trigger(agent);
-    memory_t mem;
-    mem[EVENT_DATA_ID__VALUE] = 0;
-    mem[EVENT_DATA_ID__PENALTY_FB] = 0;
-    eval_hw->TriggerEvent("MazeLocation", maze_tags[TMaze::GetCellType(TMaze::CellType::START)], mem);
+    eval_hw->TriggerEvent("MazeLocation", maze_tags[TMaze::GetCellType(TMaze::CellType::START)], start_event_mem);
 
   });
 
@@ -1557,13 +1526,13 @@ void Experiment::DoConfig__Experiment() {
         
     if (AFTER_ACTION__RESET) {
       eval_hw->ResetHardware(AFTER_ACTION__WIPE_SHARED_MEM, AFTER_ACTION__CLEAR_FUNC_REF_MODS);
+      if (AFTER_ACTION__CLEAR_FUNC_REF_MODS) match_cache.InvalidateRegulated();
     }
 
     if (AFTER_ACTION__SIGNAL) {
       TMaze::Cell & cell = maze.GetCell(eval_hw->GetTrait(TRAIT_ID__LOC));
-      memory_t mem;
-      mem[EVENT_DATA_ID__VALUE] = eval_hw->GetTrait(TRAIT_ID__REWARD_VALUE); 
-      eval_hw->TriggerEvent("MazeLocation", maze_tags[TMaze::GetCellType(cell.GetType())], mem);
+      action_event_mem[EVENT_DATA_ID__VALUE] = eval_hw->GetTrait(TRAIT_ID__REWARD_VALUE); 
+      eval_hw->TriggerEvent("MazeLocation", maze_tags[TMaze::GetCellType(cell.GetType())], action_event_mem);
     }
 
     // After action clean-up
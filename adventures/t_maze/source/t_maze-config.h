@@ -16,6 +16,7 @@ EMP_BUILD_CONFIG( TMazeConfig,
   VALUE(ELITE_SELECT__ELITE_CNT, size_t, 1, "How many elites get free reproduction passes?"),
   GROUP(EVALUATION_GROUP, "Agent evaluation settings"),
   VALUE(EVALUATION_CNT, size_t, 1, "How many fitness evaluations to do per agent fitness calculation?"),
+  VALUE(EVAL_GENOTYPE_CACHE, bool, true, "Evaluate each unique genotype only once per generation? (copies reuse phenotype of first copy evaluated)"),
   VALUE(MAZE_TRIAL_CNT, size_t, 10, "How many trials (maze runs) is a single evaluation? "),
   VALUE(REWARD_SWITCH_TRIAL_MIN, size_t, 35, "..."),
   VALUE(REWARD_SWITCH_TRIAL_MAX, size_t, 65, "..."),
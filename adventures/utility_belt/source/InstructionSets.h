@@ -0,0 +1,107 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_INSTRUCTION_SETS_H
+#define SGP_ADVENTURE_TOOLBELT_INSTRUCTION_SETS_H
+
+#include <functional>
+
+#include "base/assert.h"
+#include "hardware/EventDrivenGP.h"
+#include "hardware/InstLib.h"
+
+#include "utilities.h"
+
+// Instruction set pieces shared by the adventures' DoConfig__Hardware (and the throughput
+// benchmark, which builds the same instruction sets).
+namespace toolbelt {
+
+  /// Add the standard SignalGP instructions every adventure's instruction set starts with
+  /// (arithmetic, comparison, block, and memory instructions, and Nop).
+  ///  - If call_fun is given, it's added as Call right after Break (where env_coordination and
+  ///    div_of_labor put it). t_maze and ab_response add their own Call after Nop.
+  ///  - INST_LIB only needs HARDWARE::inst_lib_t's AddInst (the throughput benchmark passes a
+  ///    builder that wraps instructions before adding them).
+  template <typename HARDWARE, typename INST_LIB=typename HARDWARE::inst_lib_t>
+  void AddStandardInstructions(INST_LIB & inst_lib,
+                               const std::function<void(HARDWARE &, const typename HARDWARE::inst_t &)> & call_fun=nullptr) {
+    using hardware_t = HARDWARE;
+    inst_lib.AddInst("Inc", hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
+    inst_lib.AddInst("Dec", hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
+    inst_lib.AddInst("Not", hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
+    inst_lib.AddInst("Add", hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
+    inst_lib.AddInst("Sub", hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
+    inst_lib.AddInst("Mult", hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
+    inst_lib.AddInst("Div", hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
+    inst_lib.AddInst("Mod", hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
+    inst_lib.AddInst("TestEqu", hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
+    inst_lib.AddInst("TestNEqu", hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
+    inst_lib.AddInst("TestLess", hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
+    inst_lib.AddInst("If", hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
+    inst_lib.AddInst("While", hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
+    inst_lib.AddInst("Countdown", hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
+    inst_lib.AddInst("Close", hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
+    inst_lib.AddInst("Break", hardware_t::Inst_Break, 0, "Break out of current block.");
+    if (call_fun) {
+      inst_lib.AddInst("Call", call_fun, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
+    }
+    inst_lib.AddInst("Return", hardware_t::Inst_Return, 0, "Return from current function if possible.");
+    inst_lib.AddInst("SetMem", hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
+    inst_lib.AddInst("CopyMem", hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
+    inst_lib.AddInst("SwapMem", hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
+    inst_lib.AddInst("Input", hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
+    inst_lib.AddInst("Output", hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
+    inst_lib.AddInst("Commit", hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
+    inst_lib.AddInst("Pull", hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
+    inst_lib.AddInst("Nop", hardware_t::Inst_Nop, 0, "No operation.");
+  }
+
+  /// Instruction: Terminate
+  /// Description: Kill current thread (pop all the call states from current core).
+  template <typename HARDWARE>
+  void Inst_Terminate(HARDWARE & hw, const typename HARDWARE::inst_t & inst) {
+    typename HARDWARE::exec_stk_t & core = hw.GetCurCore();
+    core.resize(0);
+  }
+
+  /// Instruction: Nand
+  /// Description: WM[ARG3]=~(WM[ARG1]&WM[ARG2]), treating memory values as TASK_IO_T.
+  template <typename HARDWARE, typename TASK_IO_T>
+  void Inst_Nand(HARDWARE & hw, const typename HARDWARE::inst_t & inst) {
+    typename HARDWARE::State & state = hw.GetCurState();
+    const TASK_IO_T a = (TASK_IO_T)state.GetLocal(inst.args[0]);
+    const TASK_IO_T b = (TASK_IO_T)state.GetLocal(inst.args[1]);
+    state.SetLocal(inst.args[2], ~(a&b));
+  }
+
+  /// Add Promote/Repress (function regulation) instructions. Each adjusts the reference modifier of
+  /// the function that best matches the instruction's tag: by adding/subtracting adjustment or, if
+  /// multiplicative, by multiplying/dividing by it.
+  ///  - match_cache must be the cache for the hardware these instructions run on (and must outlive
+  ///    the instruction library).
+  ///  - modify_reg: do regulated (reference-modified) tag matches pick the target?
+  template <typename HARDWARE, typename INST_LIB=typename HARDWARE::inst_lib_t>
+  void AddRegulationInstructions(INST_LIB & inst_lib, TagMatchCache<HARDWARE> & match_cache,
+                                 double adjustment, bool multiplicative, bool modify_reg) {
+    using hardware_t = HARDWARE;
+    using inst_t = typename hardware_t::inst_t;
+    using program_t = typename hardware_t::Program;
+    emp_assert(!multiplicative || adjustment != 0);
+    const double promote_by = adjustment;
+    const double repress_by = (multiplicative) ? (1/adjustment) : -adjustment;
+    auto regulate = [&match_cache, multiplicative, modify_reg](hardware_t & hw, const inst_t & inst, double by) {
+      size_t targetID;
+      if (!match_cache.FindFunction(hw, inst.affinity, 0.0, modify_reg, targetID)) return;
+      program_t & program = hw.GetProgram();
+      double cur_mod = program[targetID].GetRefModifier();
+      program[targetID].SetRefModifier((multiplicative) ? (cur_mod * by) : (cur_mod + by));
+      match_cache.InvalidateRegulated();
+    };
+    inst_lib.AddInst("Promote", [regulate, promote_by](hardware_t & hw, const inst_t & inst) {
+      regulate(hw, inst, promote_by);
+    }, 0, "Up regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
+    inst_lib.AddInst("Repress", [regulate, repress_by](hardware_t & hw, const inst_t & inst) {
+      regulate(hw, inst, repress_by);
+    }, 0, "Down regulate target function. Use tag to determine function target.", emp::ScopeType::BASIC, 0, {"affinity"});
+  }
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_LOGIC9_H
+#define SGP_ADVENTURE_TOOLBELT_LOGIC9_H
+
+#include <cstdint>
+#include <cstddef>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "base/assert.h"
+#include "base/vector.h"
+
+namespace toolbelt {
+
+  /// Two-input bitwise logic functions, encoded as 4-bit truth tables. Bit (2*a_bit + b_bit) of the
+  /// op gives the output bit for input bits a_bit, b_bit; e.g., AND = 0b1000, XOR = 0b0110.
+  using logic_op_t = uint8_t;
+
+  namespace LogicOp {
+    constexpr logic_op_t ECHO_A  = 0xC;   ///< a
+    constexpr logic_op_t ECHO_B  = 0xA;   ///< b
+    constexpr logic_op_t NOT_A   = 0x3;   ///< ~a
+    constexpr logic_op_t NOT_B   = 0x5;   ///< ~b
+    constexpr logic_op_t NAND    = 0x7;   ///< ~(a&b)
+    constexpr logic_op_t AND     = 0x8;   ///< a&b
+    constexpr logic_op_t OR      = 0xE;   ///< a|b
+    constexpr logic_op_t NOR     = 0x1;   ///< ~(a|b)
+    constexpr logic_op_t XOR     = 0x6;   ///< a^b
+    constexpr logic_op_t EQU     = 0x9;   ///< ~(a^b)
+    constexpr logic_op_t ORN_AB  = 0xD;   ///< a|~b
+    constexpr logic_op_t ORN_BA  = 0xB;   ///< b|~a
+    constexpr logic_op_t ANDN_AB = 0x4;   ///< a&~b
+    constexpr logic_op_t ANDN_BA = 0x2;   ///< b&~a
+  }
+
+  /// All-ones if given truth table bit is set, otherwise 0.
+  constexpr uint32_t LogicMask(logic_op_t op, size_t bit) { return ((op >> bit) & 1) ? ~(uint32_t)0 : 0; }
+
+  /// Apply given logic op to a and b.
+  constexpr uint32_t ApplyLogicOp(logic_op_t op, uint32_t a, uint32_t b) {
+    return (a & b & LogicMask(op, 3)) | (a & ~b & LogicMask(op, 2))
+         | (~a & b & LogicMask(op, 1)) | (~a & ~b & LogicMask(op, 0));
+  }
+
+  /// A logic9 task: name, description, and the logic op(s) that produce its solution(s).
+  struct Logic9Task {
+    const char * name;
+    const char * desc;
+    size_t op_cnt;
+    logic_op_t ops[2];
+  };
+
+  /// The logic9 task battery (plus ECHO, last, which not every experiment uses).
+  constexpr size_t LOGIC9_TASK_CNT = 10;
+  constexpr Logic9Task LOGIC9_TASKS[LOGIC9_TASK_CNT] = {
+    {"NAND", "NAND task", 1, {LogicOp::NAND, 0}},
+    {"NOT",  "NOT task",  2, {LogicOp::NOT_A, LogicOp::NOT_B}},
+    {"ORN",  "ORN task",  2, {LogicOp::ORN_AB, LogicOp::ORN_BA}},
+    {"AND",  "AND task",  1, {LogicOp::AND, 0}},
+    {"OR",   "OR task",   1, {LogicOp::OR, 0}},
+    {"ANDN", "ANDN task", 2, {LogicOp::ANDN_AB, LogicOp::ANDN_BA}},
+    {"NOR",  "NOR task",  1, {LogicOp::NOR, 0}},
+    {"XOR",  "XOR task",  1, {LogicOp::XOR, 0}},
+    {"EQU",  "EQU task",  1, {LogicOp::EQU, 0}},
+    {"ECHO", "ECHO task", 2, {LogicOp::ECHO_A, LogicOp::ECHO_B}}
+  };
+
+  static_assert(ApplyLogicOp(LogicOp::ORN_AB, 0xF0, 0xCC) == (0xF0u | ~0xCCu), "Bad ORN_AB truth table.");
+  static_assert(ApplyLogicOp(LogicOp::ANDN_BA, 0xF0, 0xCC) == (0xCCu & ~0xF0u), "Bad ANDN_BA truth table.");
+  static_assert(ApplyLogicOp(LogicOp::EQU, 0xF0, 0xCC) == ~(0xF0u ^ 0xCCu), "Bad EQU truth table.");
+
+  /// LogicBattery evaluates a fixed list of logic ops on input pairs, one SIMD lane per op: each
+  /// op's truth table is expanded into four lane masks up front, so every op in the battery is
+  /// computed with the same (branch-free) expression.
+  ///  - Output is laid out pair by pair: pair i's results are out[i*GetSize() .. (i+1)*GetSize()).
+  class LogicBattery {
+    protected:
+      static constexpr size_t LANES = 8;
+
+      emp::vector<logic_op_t> ops;
+      emp::vector<uint32_t> masks;   ///< Per LANES-op block: LANES masks for each truth table bit (3..0).
+
+      size_t GetBlockCnt() const { return (ops.size() + LANES - 1) / LANES; }
+
+      void BuildMasks() {
+        masks.resize(GetBlockCnt() * 4 * LANES);
+        for (size_t k = 0; k < GetBlockCnt() * LANES; ++k) {
+          const size_t block = k / LANES, lane = k % LANES;
+          const logic_op_t op = (k < ops.size()) ? ops[k] : 0;
+          for (size_t bit = 0; bit < 4; ++bit) masks[(block * 4 + (3 - bit)) * LANES + lane] = LogicMask(op, bit);
+        }
+      }
+
+    public:
+      LogicBattery() : ops(), masks() { ; }
+
+      size_t GetSize() const { return ops.size(); }
+      logic_op_t GetOp(size_t i) const { return ops[i]; }
+
+      void Clear() { ops.clear(); masks.clear(); }
+
+      void AddOp(logic_op_t op) {
+        ops.emplace_back(op);
+        BuildMasks();
+      }
+
+      /// Compute all ops for n input pairs (a[i], b[i]).
+      void SolveBatch(const uint32_t * a, const uint32_t * b, size_t n, uint32_t * out) const {
+        const size_t op_cnt = ops.size();
+        for (size_t i = 0; i < n; ++i) {
+          const uint32_t x = a[i], y = b[i];
+          uint32_t * pair_out = out + i * op_cnt;
+          size_t block = 0;
+        #if defined(__AVX2__)
+          const __m256i va = _mm256_set1_epi32((int)x), vb = _mm256_set1_epi32((int)y);
+          const __m256i ones = _mm256_set1_epi32(-1);
+          const __m256i na = _mm256_xor_si256(va, ones), nb = _mm256_xor_si256(vb, ones);
+          const __m256i t11 = _mm256_and_si256(va, vb), t10 = _mm256_and_si256(va, nb);
+          const __m256i t01 = _mm256_and_si256(na, vb), t00 = _mm256_and_si256(na, nb);
+          for (; block < op_cnt / LANES; ++block) {
+            const __m256i * m = (const __m256i *)(masks.data() + block * 4 * LANES);
+            const __m256i r = _mm256_or_si256(
+              _mm256_or_si256(_mm256_and_si256(t11, _mm256_loadu_si256(m)), _mm256_and_si256(t10, _mm256_loadu_si256(m + 1))),
+              _mm256_or_si256(_mm256_and_si256(t01, _mm256_loadu_si256(m + 2)), _mm256_and_si256(t00, _mm256_loadu_si256(m + 3))));
+            _mm256_storeu_si256((__m256i *)(pair_out + block * LANES), r);
+          }
+        #elif defined(__SSE2__)
+          const __m128i va = _mm_set1_epi32((int)x), vb = _mm_set1_epi32((int)y);
+          const __m128i ones = _mm_set1_epi32(-1);
+          const __m128i na = _mm_xor_si128(va, ones), nb = _mm_xor_si128(vb, ones);
+          const __m128i t11 = _mm_and_si128(va, vb), t10 = _mm_and_si128(va, nb);
+          const __m128i t01 = _mm_and_si128(na, vb), t00 = _mm_and_si128(na, nb);
+          for (; block < op_cnt / LANES; ++block) {
+            const uint32_t * m = masks.data() + block * 4 * LANES;
+            for (size_t half = 0; half < LANES; half += 4) {
+              const __m128i r = _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(t11, _mm_loadu_si128((const __m128i *)(m + half))),
+                             _mm_and_si128(t10, _mm_loadu_si128((const __m128i *)(m + LANES + half)))),
+                _mm_or_si128(_mm_and_si128(t01, _mm_loadu_si128((const __m128i *)(m + 2 * LANES + half))),
+                             _mm_and_si128(t00, _mm_loadu_si128((const __m128i *)(m + 3 * LANES + half)))));
+              _mm_storeu_si128((__m128i *)(pair_out + block * LANES + half), r);
+            }
+          }
+        #endif
+          // Remaining ops (all ops without SIMD support).
+          for (size_t k = block * LANES; k < op_cnt; ++k) pair_out[k] = ApplyLogicOp(ops[k], x, y);
+        }
+      }
+
+      /// Compute all ops for a single input pair.
+      void Solve(uint32_t a, uint32_t b, uint32_t * out) const { SolveBatch(&a, &b, 1, out); }
+  };
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_OBJECT_POOL_H
+#define SGP_ADVENTURE_TOOLBELT_OBJECT_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "base/assert.h"
+#include "base/Ptr.h"
+#include "base/vector.h"
+
+namespace toolbelt {
+
+  /// ObjectPool recycles heap-allocated objects (e.g., SignalGP programs). Released objects are
+  /// kept whole, and acquiring one copy-assigns into it: for a program, that reuses its function
+  /// and instruction vectors' existing capacity rather than allocating fresh ones.
+  ///  - With generational selection, the dying generation's programs become the storage for the
+  ///    next generation's offspring, so (once the pool is warm) copying a population doesn't
+  ///    touch the allocator.
+  ///  - Acquire/Release are thread-safe.
+  ///  - The pool must outlive every object acquired from it.
+  template <typename T>
+  class ObjectPool {
+    protected:
+      emp::vector<emp::Ptr<T>> free_objs;
+      size_t max_free;   ///< Released objects beyond this many are deleted. (0 = no limit)
+      mutable std::mutex free_mutex;
+
+    public:
+      ObjectPool(size_t _max_free=0) : free_objs(), max_free(_max_free), free_mutex() { ; }
+      ObjectPool(const ObjectPool &) = delete;
+      ObjectPool & operator=(const ObjectPool &) = delete;
+      ~ObjectPool() { Clear(); }
+
+      size_t GetFreeCnt() const {
+        std::lock_guard<std::mutex> lock(free_mutex);
+        return free_objs.size();
+      }
+      size_t GetMaxFree() const { return max_free; }
+      void SetMaxFree(size_t val) { max_free = val; }
+
+      /// Delete all free objects.
+      void Clear() {
+        std::lock_guard<std::mutex> lock(free_mutex);
+        for (size_t i = 0; i < free_objs.size(); ++i) free_objs[i].Delete();
+        free_objs.clear();
+      }
+
+      /// Get an object holding a copy of val (recycled if any are free).
+      emp::Ptr<T> Acquire(const T & val) {
+        emp::Ptr<T> obj(nullptr);
+        {
+          std::lock_guard<std::mutex> lock(free_mutex);
+          if (free_objs.size()) {
+            obj = free_objs.back();
+            free_objs.pop_back();
+          }
+        }
+        if (obj == nullptr) return emp::NewPtr<T>(val);
+        *obj = val;
+        return obj;
+      }
+
+      /// Return an object (acquired from this pool) for reuse.
+      void Release(emp::Ptr<T> obj) {
+        emp_assert(obj != nullptr);
+        {
+          std::lock_guard<std::mutex> lock(free_mutex);
+          if (max_free == 0 || free_objs.size() < max_free) {
+            free_objs.emplace_back(obj);
+            return;
+          }
+        }
+        obj.Delete();
+      }
+
+      /// Acquire an object owned by a shared_ptr that releases it back to this pool.
+      std::shared_ptr<T> AcquireShared(const T & val) {
+        return std::shared_ptr<T>(Acquire(val).Raw(), [this](T * obj) { Release(emp::Ptr<T>(obj)); });
+      }
+  };
+
+  /// Pooled is a value-semantic handle to an object acquired from an ObjectPool: copying a Pooled
+  /// object copies the value (into a recycled object), and destroying one releases its object
+  /// back to the pool. Without a pool, objects are allocated/deleted as usual.
+  template <typename T>
+  class Pooled {
+    public:
+      using pool_t = ObjectPool<T>;
+
+    protected:
+      emp::Ptr<T> obj;
+      emp::Ptr<pool_t> pool;
+
+      static emp::Ptr<T> Make(const T & val, emp::Ptr<pool_t> pool) {
+        return (pool != nullptr) ? pool->Acquire(val) : emp::NewPtr<T>(val);
+      }
+
+      void Free() {
+        if (obj == nullptr) return;
+        if (pool != nullptr) pool->Release(obj);
+        else obj.Delete();
+        obj = nullptr;
+      }
+
+    public:
+      Pooled(const T & val, emp::Ptr<pool_t> _pool=nullptr) : obj(Make(val, _pool)), pool(_pool) { ; }
+      Pooled(const Pooled & in) : obj(Make(*in.obj, in.pool)), pool(in.pool) { ; }
+      Pooled(Pooled && in) noexcept : obj(in.obj), pool(in.pool) { in.obj = nullptr; }
+      ~Pooled() { Free(); }
+
+      Pooled & operator=(const Pooled & in) {
+        if (this == &in) return *this;
+        if (obj == nullptr) obj = Make(*in.obj, pool);
+        else *obj = *in.obj;
+        return *this;
+      }
+
+      Pooled & operator=(Pooled && in) noexcept {
+        std::swap(obj, in.obj);
+        std::swap(pool, in.pool);
+        return *this;
+      }
+
+      emp::Ptr<pool_t> GetPool() const { return pool; }
+
+      T & Get() { emp_assert(obj != nullptr); return *obj; }
+      const T & Get() const { emp_assert(obj != nullptr); return *obj; }
+      T & operator*() { return Get(); }
+      const T & operator*() const { return Get(); }
+      T * operator->() { return &Get(); }
+      const T * operator->() const { return &Get(); }
+  };
+
+}
+
+#endif
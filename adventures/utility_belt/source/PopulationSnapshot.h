@@ -0,0 +1,418 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_POPULATION_SNAPSHOT_H
+#define SGP_ADVENTURE_TOOLBELT_POPULATION_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base/assert.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+
+#include "utilities.h"
+
+namespace toolbelt {
+
+  /// Binary population files (.bpop) are a compact alternative to PrintProgramFull text for
+  /// population snapshots. Layout (native byte order; each section starts on an 8-byte boundary):
+  ///  - PopulationFileHeader
+  ///  - Programs: uint64 ID, double fitness, double aux (experiment-defined; e.g., similarity
+  ///    threshold), each program_cnt long; then uint64 function offsets (program_cnt + 1)
+  ///  - Functions: uint64 instruction offsets (function_cnt + 1); packed tags
+  ///  - Instructions: uint16 instruction IDs; int32 arguments (max_inst_args per instruction);
+  ///    packed tags
+  /// Tags are packed into the smallest integer that holds them (see PackTag): 16-bit tags take
+  /// two bytes. The header carries a fingerprint of the instruction library (instruction names and
+  /// argument counts, in order), so files only load against the library they were written with.
+  struct PopulationFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t tag_width;       ///< Tag width (bits)
+    uint32_t tag_bytes;       ///< Bytes per packed tag
+    uint32_t max_inst_args;
+    uint64_t inst_lib_fingerprint;
+    uint64_t program_cnt;
+    uint64_t function_cnt;
+    uint64_t inst_cnt;
+  };
+
+  constexpr char POPULATION_FILE_MAGIC[8] = {'S', 'G', 'P', 'B', 'P', 'O', 'P', '\0'};
+  constexpr uint32_t POPULATION_FILE_VERSION = 1;
+
+  /// Byte offsets of each section of a population file (given its header).
+  struct PopulationFileLayout {
+    size_t prog_ids, prog_fitness, prog_aux, prog_funcs;
+    size_t func_insts, func_tags;
+    size_t inst_ids, inst_args, inst_tags;
+    size_t total;
+
+    static size_t Align(size_t pos) { return (pos + 7) & ~((size_t)7); }
+
+    PopulationFileLayout() : prog_ids(0), prog_fitness(0), prog_aux(0), prog_funcs(0), func_insts(0),
+                             func_tags(0), inst_ids(0), inst_args(0), inst_tags(0), total(0) { ; }
+
+    PopulationFileLayout(const PopulationFileHeader & h) {
+      const size_t prog_cnt = h.program_cnt, func_cnt = h.function_cnt, inst_cnt = h.inst_cnt;
+      prog_ids = Align(sizeof(PopulationFileHeader));
+      prog_fitness = Align(prog_ids + prog_cnt * sizeof(uint64_t));
+      prog_aux = Align(prog_fitness + prog_cnt * sizeof(double));
+      prog_funcs = Align(prog_aux + prog_cnt * sizeof(double));
+      func_insts = Align(prog_funcs + (prog_cnt + 1) * sizeof(uint64_t));
+      func_tags = Align(func_insts + (func_cnt + 1) * sizeof(uint64_t));
+      inst_ids = Align(func_tags + func_cnt * h.tag_bytes);
+      inst_args = Align(inst_ids + inst_cnt * sizeof(uint16_t));
+      inst_tags = Align(inst_args + inst_cnt * h.max_inst_args * sizeof(int32_t));
+      total = Align(inst_tags + inst_cnt * h.tag_bytes);
+    }
+  };
+
+  /// Fingerprint (64-bit FNV-1a) of an instruction library: instruction names and argument counts,
+  /// in instruction ID order.
+  template <typename INST_LIB>
+  uint64_t InstLibFingerprint(const INST_LIB & inst_lib) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](unsigned char c) { hash ^= c; hash *= 1099511628211ULL; };
+    for (size_t id = 0; id < inst_lib.GetSize(); ++id) {
+      const std::string & name = inst_lib.GetName(id);
+      for (size_t i = 0; i < name.size(); ++i) mix((unsigned char)name[i]);
+      mix(0);
+      mix((unsigned char)inst_lib.GetNumArgs(id));
+    }
+    return hash;
+  }
+
+  /// PopulationFileWriter collects programs (plus per-program ID/fitness/aux values) and writes
+  /// them out as a binary population file.
+  template <typename HARDWARE>
+  class PopulationFileWriter {
+    public:
+      using hardware_t = HARDWARE;
+      using program_t = typename hardware_t::program_t;
+      using inst_lib_t = typename hardware_t::inst_lib_t;
+      using tag_t = typename hardware_t::affinity_t;
+      static constexpr size_t TAG_WIDTH = TagWidth<tag_t>::value;
+      static constexpr size_t MAX_INST_ARGS = hardware_t::MAX_INST_ARGS;
+      using packed_t = packed_tag_t<TAG_WIDTH>;
+
+    protected:
+      uint64_t fingerprint;
+      emp::vector<uint64_t> prog_ids;
+      emp::vector<double> prog_fitness;
+      emp::vector<double> prog_aux;
+      emp::vector<uint64_t> prog_funcs;   ///< Function offset of each program (+ end sentinel)
+      emp::vector<uint64_t> func_insts;   ///< Instruction offset of each function (+ end sentinel)
+      emp::vector<packed_t> func_tags;
+      emp::vector<uint16_t> inst_ids;
+      emp::vector<int32_t> inst_args;
+      emp::vector<packed_t> inst_tags;
+
+      template <typename T>
+      static void WriteSection(std::ostream & os, size_t & pos, size_t offset, const T * data, size_t cnt) {
+        static const char padding[8] = {0};
+        emp_assert(offset >= pos && offset - pos < 8);
+        os.write(padding, offset - pos);
+        os.write(reinterpret_cast<const char *>(data), cnt * sizeof(T));
+        pos = offset + cnt * sizeof(T);
+      }
+
+    public:
+      PopulationFileWriter(const inst_lib_t & inst_lib)
+        : fingerprint(InstLibFingerprint(inst_lib)), prog_ids(), prog_fitness(), prog_aux(),
+          prog_funcs(1, 0), func_insts(1, 0), func_tags(), inst_ids(), inst_args(), inst_tags() { ; }
+
+      size_t GetProgramCnt() const { return prog_ids.size(); }
+
+      void Clear() {
+        prog_ids.clear(); prog_fitness.clear(); prog_aux.clear();
+        prog_funcs.resize(1); func_insts.resize(1);
+        func_tags.clear(); inst_ids.clear(); inst_args.clear(); inst_tags.clear();
+      }
+
+      void Add(const program_t & prog, uint64_t id=0, double fitness=0.0, double aux=0.0) {
+        prog_ids.emplace_back(id);
+        prog_fitness.emplace_back(fitness);
+        prog_aux.emplace_back(aux);
+        for (size_t fID = 0; fID < prog.GetSize(); ++fID) {
+          const auto & fun = prog.program[fID];
+          func_tags.emplace_back(PackTag(fun.affinity));
+          for (size_t i = 0; i < fun.inst_seq.size(); ++i) {
+            const auto & inst = fun.inst_seq[i];
+            emp_assert(inst.id <= UINT16_MAX, inst.id);
+            inst_ids.emplace_back((uint16_t)inst.id);
+            for (size_t k = 0; k < MAX_INST_ARGS; ++k) inst_args.emplace_back((int32_t)inst.args[k]);
+            inst_tags.emplace_back(PackTag(inst.affinity));
+          }
+          func_insts.emplace_back(inst_ids.size());
+        }
+        prog_funcs.emplace_back(func_tags.size());
+      }
+
+      /// Write collected programs to given file. Returns false if the file can't be written.
+      bool Write(const std::string & fpath) const {
+        PopulationFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, POPULATION_FILE_MAGIC, sizeof(header.magic));
+        header.version = POPULATION_FILE_VERSION;
+        header.tag_width = TAG_WIDTH;
+        header.tag_bytes = sizeof(packed_t);
+        header.max_inst_args = MAX_INST_ARGS;
+        header.inst_lib_fingerprint = fingerprint;
+        header.program_cnt = prog_ids.size();
+        header.function_cnt = func_tags.size();
+        header.inst_cnt = inst_ids.size();
+        const PopulationFileLayout layout(header);
+
+        std::ofstream os(fpath, std::ios::binary);
+        if (!os.is_open()) return false;
+        os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        size_t pos = sizeof(header);
+        WriteSection(os, pos, layout.prog_ids, prog_ids.data(), prog_ids.size());
+        WriteSection(os, pos, layout.prog_fitness, prog_fitness.data(), prog_fitness.size());
+        WriteSection(os, pos, layout.prog_aux, prog_aux.data(), prog_aux.size());
+        WriteSection(os, pos, layout.prog_funcs, prog_funcs.data(), prog_funcs.size());
+        WriteSection(os, pos, layout.func_insts, func_insts.data(), func_insts.size());
+        WriteSection(os, pos, layout.func_tags, func_tags.data(), func_tags.size());
+        WriteSection(os, pos, layout.inst_ids, inst_ids.data(), inst_ids.size());
+        WriteSection(os, pos, layout.inst_args, inst_args.data(), inst_args.size());
+        WriteSection(os, pos, layout.inst_tags, inst_tags.data(), inst_tags.size());
+        WriteSection(os, pos, layout.total, (const char *)nullptr, 0);
+        return os.good();
+      }
+  };
+
+  /// PopulationFileView maps a binary population file into memory (read-only) and reads programs
+  /// straight out of the mapping: nothing is parsed or copied until a program is loaded.
+  class PopulationFileView {
+    protected:
+      void * map;
+      size_t map_size;
+      const unsigned char * base;
+      PopulationFileHeader header;
+      PopulationFileLayout layout;
+
+      template <typename T>
+      const T * Section(size_t offset) const { return reinterpret_cast<const T *>(base + offset); }
+
+      uint64_t ReadTag(size_t offset, size_t idx) const {
+        uint64_t packed = 0;
+        std::memcpy(&packed, base + offset + idx * header.tag_bytes, header.tag_bytes);
+        return packed;
+      }
+
+      /// Check that offsets (function offsets of programs, instruction offsets of functions) are
+      /// in bounds and non-decreasing.
+      static bool CheckOffsets(const uint64_t * offsets, size_t cnt, uint64_t end) {
+        if (offsets[0] != 0 || offsets[cnt] != end) return false;
+        for (size_t i = 0; i < cnt; ++i) if (offsets[i] > offsets[i + 1]) return false;
+        return true;
+      }
+
+      /// Compute the layout from the header; returns false if it doesn't fit in the mapped file.
+      /// Counts are checked against the file size first (every program/function has an 8-byte
+      /// offset, every instruction a 2-byte ID and max_inst_args 4-byte arguments), so corrupt
+      /// counts can't overflow the layout computation.
+      bool SetupLayout() {
+        if (header.program_cnt >= map_size / sizeof(uint64_t)) return false;
+        if (header.function_cnt >= map_size / sizeof(uint64_t)) return false;
+        if (header.inst_cnt > map_size / sizeof(uint16_t)) return false;
+        if (header.max_inst_args > map_size / sizeof(int32_t)) return false;
+        if (header.max_inst_args && header.inst_cnt > map_size / (header.max_inst_args * sizeof(int32_t))) return false;
+        layout = PopulationFileLayout(header);
+        return layout.total <= map_size;
+      }
+
+    public:
+      PopulationFileView() : map(nullptr), map_size(0), base(nullptr), header(), layout() { ; }
+      PopulationFileView(const PopulationFileView &) = delete;
+      PopulationFileView & operator=(const PopulationFileView &) = delete;
+      ~PopulationFileView() { Close(); }
+
+      /// Does given file start like a binary population file?
+      static bool IsPopulationFile(const std::string & fpath) {
+        std::ifstream is(fpath, std::ios::binary);
+        char magic[sizeof(POPULATION_FILE_MAGIC)];
+        if (!is.read(magic, sizeof(magic))) return false;
+        return std::memcmp(magic, POPULATION_FILE_MAGIC, sizeof(magic)) == 0;
+      }
+
+      /// Map given file. Returns false (and describes the problem in error) if the file can't be
+      /// mapped or isn't a valid population file.
+      bool Open(const std::string & fpath, std::string & error) {
+        Close();
+        const int fd = open(fpath.c_str(), O_RDONLY);
+        if (fd < 0) { error = "Failed to open " + fpath; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(PopulationFileHeader)) {
+          close(fd);
+          error = fpath + " is too small to be a population file";
+          return false;
+        }
+        map_size = (size_t)st.st_size;
+        map = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);  // The mapping stays valid after the file is closed.
+        if (map == MAP_FAILED) { map = nullptr; map_size = 0; error = "Failed to map " + fpath; return false; }
+        base = static_cast<const unsigned char *>(map);
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, POPULATION_FILE_MAGIC, sizeof(header.magic)) != 0) {
+          error = fpath + " is not a binary population file";
+        } else if (header.version != POPULATION_FILE_VERSION) {
+          error = fpath + " has unsupported version " + std::to_string(header.version);
+        } else if (header.tag_width == 0 || header.tag_width > 64 || header.tag_bytes * 8 < header.tag_width
+                   || header.tag_bytes > sizeof(uint64_t)) {
+          error = fpath + " has bad tag width/size";
+        } else if (!SetupLayout()) {
+          error = fpath + " is truncated (or has corrupt counts)";
+        } else if (!CheckOffsets(Section<uint64_t>(layout.prog_funcs), header.program_cnt, header.function_cnt)
+                   || !CheckOffsets(Section<uint64_t>(layout.func_insts), header.function_cnt, header.inst_cnt)) {
+          error = fpath + " has inconsistent program/function offsets";
+        } else {
+          return true;
+        }
+        Close();
+        return false;
+      }
+
+      void Close() {
+        if (map != nullptr) munmap(map, map_size);
+        map = nullptr;
+        map_size = 0;
+        base = nullptr;
+      }
+
+      bool IsOpen() const { return map != nullptr; }
+      const PopulationFileHeader & GetHeader() const { return header; }
+
+      /// Can this file's programs be loaded with given hardware/instruction library?
+      template <typename HARDWARE>
+      bool IsCompatible(const typename HARDWARE::inst_lib_t & inst_lib, std::string & error) const {
+        emp_assert(IsOpen());
+        if (header.tag_width != TagWidth<typename HARDWARE::affinity_t>::value) {
+          error = "Tag width mismatch (file has " + std::to_string(header.tag_width) + "-bit tags)";
+          return false;
+        }
+        if (header.max_inst_args != HARDWARE::MAX_INST_ARGS) {
+          error = "Instruction argument count mismatch";
+          return false;
+        }
+        if (header.inst_lib_fingerprint != InstLibFingerprint(inst_lib)) {
+          error = "Instruction library mismatch (file was written with a different instruction set)";
+          return false;
+        }
+        for (size_t i = 0; i < header.inst_cnt; ++i) {
+          if (GetInstID(i) >= inst_lib.GetSize()) {
+            error = "Invalid instruction ID (" + std::to_string(GetInstID(i)) + ")";
+            return false;
+          }
+        }
+        return true;
+      }
+
+      size_t GetProgramCnt() const { return header.program_cnt; }
+      uint64_t GetProgramID(size_t pID) const { return Section<uint64_t>(layout.prog_ids)[pID]; }
+      double GetFitness(size_t pID) const { return Section<double>(layout.prog_fitness)[pID]; }
+      double GetAux(size_t pID) const { return Section<double>(layout.prog_aux)[pID]; }
+
+      /// Functions of program pID are [GetFunctionBegin(pID), GetFunctionBegin(pID + 1)) (file-wide
+      /// function indices).
+      size_t GetFunctionBegin(size_t pID) const { return Section<uint64_t>(layout.prog_funcs)[pID]; }
+      size_t GetFunctionCnt(size_t pID) const { return GetFunctionBegin(pID + 1) - GetFunctionBegin(pID); }
+      uint64_t GetFunctionTag(size_t func) const { return ReadTag(layout.func_tags, func); }
+
+      /// Instructions of (file-wide) function func are [GetInstBegin(func), GetInstBegin(func + 1)).
+      size_t GetInstBegin(size_t func) const { return Section<uint64_t>(layout.func_insts)[func]; }
+      size_t GetInstCnt(size_t func) const { return GetInstBegin(func + 1) - GetInstBegin(func); }
+      size_t GetInstID(size_t inst) const { return Section<uint16_t>(layout.inst_ids)[inst]; }
+      int32_t GetInstArg(size_t inst, size_t k) const {
+        return Section<int32_t>(layout.inst_args)[inst * header.max_inst_args + k];
+      }
+      uint64_t GetInstTag(size_t inst) const { return ReadTag(layout.inst_tags, inst); }
+
+      /// Rebuild program pID into prog (which is cleared first). Check IsCompatible before loading
+      /// (it validates instruction IDs).
+      template <typename PROGRAM>
+      void LoadProgram(size_t pID, PROGRAM & prog) const {
+        using function_t = typename std::decay<decltype(prog.program[0])>::type;
+        using inst_t = typename std::decay<decltype(prog.program[0].inst_seq[0])>::type;
+        emp_assert(pID < GetProgramCnt());
+        prog.program.clear();
+        const size_t func_end = GetFunctionBegin(pID + 1);
+        for (size_t func = GetFunctionBegin(pID); func < func_end; ++func) {
+          function_t fun;
+          UnpackTag(GetFunctionTag(func), fun.affinity);
+          const size_t inst_end = GetInstBegin(func + 1);
+          for (size_t i = GetInstBegin(func); i < inst_end; ++i) {
+            inst_t inst(GetInstID(i));
+            for (size_t k = 0; k < inst.args.size() && k < header.max_inst_args; ++k) inst.args[k] = GetInstArg(i, k);
+            UnpackTag(GetInstTag(i), inst.affinity);
+            fun.inst_seq.emplace_back(inst);
+          }
+          prog.PushFunction(fun);
+        }
+      }
+  };
+
+  /// Load programs written by PrintProgramFull into writer. Handles a single program (.gp) or a
+  /// population (.pop) of programs separated by lines starting with "===". A separator of the
+  /// form "===<id>:<fitness>,<aux>===" gives the next program's ID/fitness/aux; otherwise programs
+  /// get sequential IDs (and zero fitness/aux).
+  template <typename HARDWARE>
+  size_t LoadTextPopulation(std::istream & is, emp::Ptr<const typename HARDWARE::inst_lib_t> inst_lib,
+                            PopulationFileWriter<HARDWARE> & writer) {
+    using program_t = typename HARDWARE::program_t;
+    std::string line;
+    std::string prog_text;
+    unsigned long long id = 0;
+    double fitness = 0.0, aux = 0.0;
+    size_t loaded = 0;
+    bool pending = false;   // Has a separator opened a program (possibly with no functions)?
+    auto flush = [&]() {
+      if (!pending && prog_text.find_first_not_of(" \t\r\n") == std::string::npos) return;
+      program_t prog(inst_lib);
+      std::istringstream prog_is(prog_text);
+      prog.Load(prog_is);
+      writer.Add(prog, id, fitness, aux);
+      prog_text.clear();
+      pending = false;
+      ++loaded;
+    };
+    while (std::getline(is, line)) {
+      if (line.compare(0, 3, "===") != 0) { prog_text += line + "\n"; continue; }
+      flush();
+      prog_text.clear();
+      pending = true;
+      id = loaded; fitness = 0.0; aux = 0.0;
+      std::sscanf(line.c_str(), "===%llu:%lf,%lf===", &id, &fitness, &aux);
+    }
+    flush();
+    return loaded;
+  }
+
+  /// Write every program in view as PrintProgramFull text, each preceded by an
+  /// "===<id>:<fitness>,<aux>===" line (the .pop format env_coordination snapshots use).
+  template <typename HARDWARE>
+  void WriteTextPopulation(const PopulationFileView & view,
+                           emp::Ptr<const typename HARDWARE::inst_lib_t> inst_lib, std::ostream & os) {
+    typename HARDWARE::program_t prog(inst_lib);
+    // Full precision, so that fitness/aux survive a binary => text => binary round trip.
+    const std::streamsize prev_precision = os.precision(std::numeric_limits<double>::max_digits10);
+    for (size_t pID = 0; pID < view.GetProgramCnt(); ++pID) {
+      view.LoadProgram(pID, prog);
+      os << "===" << view.GetProgramID(pID) << ":" << view.GetFitness(pID) << "," << view.GetAux(pID) << "===\n";
+      prog.PrintProgramFull(os);
+    }
+    os.precision(prev_precision);
+  }
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_SELECTION_H
+#define SGP_ADVENTURE_TOOLBELT_SELECTION_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "base/assert.h"
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "utilities.h"
+
+namespace toolbelt {
+
+  /// Call fun(i, rnd) for every i in [0, n), spread across thread_cnt threads (the calling thread
+  /// included). Each thread has its own random number generator; fun should reseed it (e.g., from
+  /// a RandomStreams key derived from i) so results don't depend on thread count.
+  template <typename FUN>
+  void ParallelFor(size_t n, size_t thread_cnt, FUN fun) {
+    // Hand out indices in small blocks: cheap per-index work (e.g., one tournament) would
+    // otherwise be dominated by contention on the counter.
+    constexpr size_t BLOCK_SIZE = 16;
+    std::atomic<size_t> next_block(0);
+    auto do_work = [n, &next_block, &fun]() {
+      emp::Random rnd(1);
+      for (size_t begin = BLOCK_SIZE * next_block++; begin < n; begin = BLOCK_SIZE * next_block++) {
+        const size_t end = std::min(n, begin + BLOCK_SIZE);
+        for (size_t i = begin; i < end; ++i) fun(i, rnd);
+      }
+    };
+    thread_cnt = std::max<size_t>(1, std::min(thread_cnt, (n + BLOCK_SIZE - 1) / BLOCK_SIZE));
+    emp::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_cnt; ++i) threads.emplace_back(do_work);
+    do_work();
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+  }
+
+  /// IDs of the elite_cnt fittest agents, fittest first. Ties go to the higher ID (as in
+  /// emp::EliteSelect).
+  inline emp::vector<size_t> SelectElites(const emp::vector<double> & fitness, size_t elite_cnt) {
+    emp::vector<size_t> ids(fitness.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = i;
+    elite_cnt = std::min(elite_cnt, ids.size());
+    std::partial_sort(ids.begin(), ids.begin() + elite_cnt, ids.end(),
+      [&fitness](size_t a, size_t b) {
+        return (fitness[a] != fitness[b]) ? (fitness[a] > fitness[b]) : (a > b);
+      });
+    ids.resize(elite_cnt);
+    return ids;
+  }
+
+  /// Run one tournament of t_size distinct entrants (drawn uniformly from all agents, except
+  /// exclude) against given fitness array; returns the winner's ID. The winner is the fittest
+  /// entrant, or the least fit if lowest (e.g., to pick an agent to replace). Ties go to the
+  /// first entrant drawn (as in emp::TournamentSelect).
+  inline size_t RunTournament(const emp::vector<double> & fitness, size_t t_size, emp::Random & rnd,
+                              bool lowest=false, size_t exclude=(size_t)-1) {
+    const size_t pop_size = fitness.size();
+    const size_t avail = (exclude < pop_size) ? pop_size - 1 : pop_size;
+    emp_assert(avail > 0);
+    t_size = std::max<size_t>(1, std::min(t_size, avail));
+    size_t entrants[64];
+    emp::vector<size_t> big_entrants;
+    size_t * drawn = entrants;
+    if (t_size > 64) { big_entrants.resize(t_size); drawn = big_entrants.data(); }
+    size_t best_id = 0;
+    double best_fit = 0.0;
+    for (size_t k = 0; k < t_size; ++k) {
+      // Rejection-sample distinct entrants (tournaments are small relative to the population).
+      size_t id = rnd.GetUInt(pop_size);
+      while (id == exclude || std::find(drawn, drawn + k, id) != drawn + k) id = rnd.GetUInt(pop_size);
+      drawn[k] = id;
+      const bool better = (lowest) ? (fitness[id] < best_fit) : (fitness[id] > best_fit);
+      if (k == 0 || better) { best_fit = fitness[id]; best_id = id; }
+    }
+    return best_id;
+  }
+
+  /// Run tourny_cnt tournaments (see RunTournament), writing each tournament's winner to winners.
+  ///  - Tournament i draws entrants from stream (gen, i) of given streams, so winners don't depend
+  ///    on thread count.
+  inline void SelectTournaments(const emp::vector<double> & fitness, size_t t_size, size_t tourny_cnt,
+                                const RandomStreams & streams, size_t gen,
+                                emp::vector<size_t> & winners, size_t thread_cnt=1) {
+    emp_assert(t_size > 0 && t_size <= fitness.size(), t_size, fitness.size());
+    winners.resize(tourny_cnt);
+    ParallelFor(tourny_cnt, thread_cnt, [&](size_t t, emp::Random & rnd) {
+      streams.SeedStream(rnd, gen, t);
+      winners[t] = RunTournament(fitness, t_size, rnd);
+    });
+  }
+
+}
+
+#endif
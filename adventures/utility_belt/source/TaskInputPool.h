@@ -0,0 +1,139 @@
+#ifndef SGP_ADVENTURE_TOOLBELT_TASK_INPUT_POOL_H
+#define SGP_ADVENTURE_TOOLBELT_TASK_INPUT_POOL_H
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "utilities.h"
+
+namespace toolbelt {
+
+  /// TaskInputPool holds a precomputed pool of collision-free task inputs along with each entry's
+  /// task solutions (stored in one flat array, task by task). Drawing trial inputs from the pool
+  /// replaces the regenerate-until-no-collision loop with a single index draw.
+  ///  - TASKSET must provide SetInputs(inputs), IsCollision(), GetSize(), GetTask(id).solutions,
+  ///    and SetSolutions(const task_output_t *, const emp::vector<size_t> & offsets).
+  ///  - Entry i is generated from its own random stream (see RandomStreams), so pool contents
+  ///    don't depend on how many threads build it.
+  template <typename TASKSET>
+  class TaskInputPool {
+    public:
+      using taskset_t = TASKSET;
+      using task_input_t = typename taskset_t::task_input_t;
+      using task_output_t = typename taskset_t::task_output_t;
+      using gen_input_fun_t = std::function<void(emp::Random &, task_input_t &)>;
+
+    protected:
+      emp::vector<task_input_t> inputs;
+      emp::vector<task_output_t> solutions;   ///< Flat: entry i's solutions start at i * stride.
+      emp::vector<size_t> sol_offsets;        ///< Per-task solution offsets within an entry (+ end).
+      size_t stride;
+
+      /// Generate collision-free inputs for given entry into given task set.
+      static void GenerateEntry(size_t entry_id, taskset_t & task_set, task_input_t & entry_inputs,
+                                emp::Random & rnd, const RandomStreams & streams,
+                                const gen_input_fun_t & gen_input) {
+        streams.SeedStream(rnd, 0, entry_id);
+        gen_input(rnd, entry_inputs);
+        task_set.SetInputs(entry_inputs);
+        while (task_set.IsCollision()) {
+          gen_input(rnd, entry_inputs);
+          task_set.SetInputs(entry_inputs);
+        }
+      }
+
+      /// Flatten task set's current solutions into entry's slot. Returns false if layout (number of
+      /// solutions per task) doesn't match the pool's.
+      bool StoreSolutions(size_t entry_id, taskset_t & task_set) {
+        task_output_t * out = solutions.data() + entry_id * stride;
+        for (size_t t = 0; t < task_set.GetSize(); ++t) {
+          const auto & task_sols = task_set.GetTask(t).solutions;
+          if (task_sols.size() != sol_offsets[t+1] - sol_offsets[t]) return false;
+          std::copy(task_sols.begin(), task_sols.end(), out + sol_offsets[t]);
+        }
+        return true;
+      }
+
+    public:
+      TaskInputPool() : inputs(), solutions(), sol_offsets(), stride(0) { ; }
+
+      size_t GetSize() const { return inputs.size(); }
+      size_t GetStride() const { return stride; }
+      const emp::vector<size_t> & GetSolutionOffsets() const { return sol_offsets; }
+
+      const task_input_t & GetInputs(size_t id) const {
+        emp_assert(id < inputs.size());
+        return inputs[id];
+      }
+
+      const task_output_t * GetSolutions(size_t id) const {
+        emp_assert(id < inputs.size());
+        return solutions.data() + id * stride;
+      }
+
+      void Clear() {
+        inputs.clear();
+        solutions.clear();
+        sol_offsets.clear();
+        stride = 0;
+      }
+
+      /// Build a pool of pool_size collision-free entries.
+      ///  - proto: task set (with tasks added) used to generate solutions (copied per thread).
+      ///  - gen_input: draws a (candidate) set of inputs from given random number generator.
+      ///  - thread_cnt: number of threads to build pool with (does not affect pool contents).
+      void Build(const taskset_t & proto, size_t pool_size, const RandomStreams & streams,
+                 const gen_input_fun_t & gen_input, size_t thread_cnt=1) {
+        Clear();
+        if (pool_size == 0) return;
+        inputs.resize(pool_size);
+
+        // Entry 0 determines solution layout.
+        taskset_t task_set(proto);
+        emp::Random rnd(1);
+        GenerateEntry(0, task_set, inputs[0], rnd, streams, gen_input);
+        sol_offsets.resize(task_set.GetSize() + 1, 0);
+        for (size_t t = 0; t < task_set.GetSize(); ++t) {
+          sol_offsets[t+1] = sol_offsets[t] + task_set.GetTask(t).solutions.size();
+        }
+        stride = sol_offsets.back();
+        solutions.resize(pool_size * stride);
+        StoreSolutions(0, task_set);
+
+        std::atomic<size_t> next_entry(1);
+        std::atomic<bool> layout_ok(true);
+        auto run_worker = [this, &proto, &streams, &gen_input, &next_entry, &layout_ok]() {
+          taskset_t worker_task_set(proto);
+          emp::Random worker_rnd(1);
+          for (size_t id = next_entry++; id < inputs.size(); id = next_entry++) {
+            GenerateEntry(id, worker_task_set, inputs[id], worker_rnd, streams, gen_input);
+            if (!StoreSolutions(id, worker_task_set)) layout_ok = false;
+          }
+        };
+        thread_cnt = std::max<size_t>(1, thread_cnt);
+        emp::vector<std::thread> threads;
+        for (size_t i = 1; i < thread_cnt; ++i) threads.emplace_back(run_worker);
+        run_worker();
+        for (auto & thread : threads) thread.join();
+
+        if (!layout_ok) {
+          std::cout << "Task input pool: number of solutions per task varies with inputs. Exiting..." << std::endl;
+          exit(-1);
+        }
+      }
+
+      /// Load given pool entry's solutions into given task set (resetting it as SetInputs would).
+      void Load(size_t id, taskset_t & task_set) const {
+        task_set.SetSolutions(GetSolutions(id), sol_offsets);
+      }
+  };
+
+}
+
+#endif
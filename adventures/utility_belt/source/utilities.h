@@ -2,6 +2,10 @@
 #define SGP_ADVENTURE_TOOLBELT_H
 
 #include <iostream>
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <utility>
 #include <fstream>
@@ -9,7 +13,12 @@
 #include <functional>
 #include <unordered_set>
 #include <unordered_map>
+#include <type_traits>
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
 
+#include "base/assert.h"
 #include "base/Ptr.h"
 #include "base/vector.h"
 #include "hardware/EventDrivenGP.h"
@@ -19,6 +28,8 @@
 #include "tools/math.h"
 #include "tools/string_utils.h"
 
+#include "ObjectPool.h"
+
 namespace toolbelt {
 
   /// Generate random tags. Can guarantee uniqueness. 
@@ -95,6 +106,464 @@ namespace toolbelt {
     return tags;
   }
 
+  /// Mix value into running hash (seed).
+  inline size_t HashCombine(size_t seed, size_t value) {
+    return seed ^ (value + (size_t)0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  }
+
+  /// Hash a tag (bit set), 64 bits at a time.
+  template<typename TAG>
+  size_t HashTag(const TAG & tag) {
+    size_t seed = tag.GetSize();
+    uint64_t word = 0;
+    for (size_t i = 0; i < tag.GetSize(); ++i) {
+      word = (word << 1) | (uint64_t)tag.Get(i);
+      if ((i & 63) == 63) { seed = HashCombine(seed, (size_t)word); word = 0; }
+    }
+    return HashCombine(seed, (size_t)word);
+  }
+
+  /// Content hash of a SignalGP program: function tags, instructions, instruction arguments, and
+  /// instruction tags. Identical programs always hash to the same value.
+  template<typename PROGRAM>
+  size_t HashProgram(const PROGRAM & program) {
+    size_t seed = program.GetSize();
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      const auto & fun = program.program[fID];
+      seed = HashCombine(seed, HashTag(fun.affinity));
+      seed = HashCombine(seed, fun.inst_seq.size());
+      for (size_t i = 0; i < fun.inst_seq.size(); ++i) {
+        const auto & inst = fun.inst_seq[i];
+        seed = HashCombine(seed, inst.id);
+        for (size_t k = 0; k < inst.args.size(); ++k) seed = HashCombine(seed, (size_t)inst.args[k]);
+        seed = HashCombine(seed, HashTag(inst.affinity));
+      }
+    }
+    return seed;
+  }
+
+  /// Are two SignalGP programs identical in everything HashProgram covers (function tags,
+  /// instructions, instruction arguments, and instruction tags)?
+  template<typename PROGRAM>
+  bool SameProgram(const PROGRAM & a, const PROGRAM & b) {
+    if (&a == &b) return true;
+    if (a.GetSize() != b.GetSize()) return false;
+    for (size_t fID = 0; fID < a.GetSize(); ++fID) {
+      const auto & fun_a = a.program[fID];
+      const auto & fun_b = b.program[fID];
+      if (fun_a.inst_seq.size() != fun_b.inst_seq.size() || fun_a.affinity != fun_b.affinity) return false;
+      for (size_t i = 0; i < fun_a.inst_seq.size(); ++i) {
+        const auto & inst_a = fun_a.inst_seq[i];
+        const auto & inst_b = fun_b.inst_seq[i];
+        if (inst_a.id != inst_b.id || inst_a.affinity != inst_b.affinity) return false;
+        for (size_t k = 0; k < inst_a.args.size(); ++k) if (inst_a.args[k] != inst_b.args[k]) return false;
+      }
+    }
+    return true;
+  }
+
+  /// GenotypeIndex groups IDs (e.g., population positions) by genotype, so that each unique
+  /// genotype can be evaluated once. IDs are looked up by genotype hash, and every hash match is
+  /// confirmed with a full comparison: genotypes whose hashes collide are never merged.
+  class GenotypeIndex {
+    protected:
+      std::unordered_map<size_t, emp::vector<size_t>> ids_by_hash;  ///< Representative IDs per hash
+
+    public:
+      GenotypeIndex() : ids_by_hash() { ; }
+
+      void Clear() { ids_by_hash.clear(); }
+
+      /// Find an already-added representative whose genotype matches id's (same(rep_id, id) is true).
+      /// If there isn't one, add id as a representative. Returns the representative's ID (id itself
+      /// if it was added).
+      template<typename SAME>
+      size_t FindOrAdd(size_t hash, size_t id, SAME same) {
+        emp::vector<size_t> & reps = ids_by_hash[hash];
+        for (size_t i = 0; i < reps.size(); ++i) if (same(reps[i], id)) return reps[i];
+        reps.emplace_back(id);
+        return id;
+      }
+  };
+
+  /// Width (in bits) of a tag type.
+  template<typename TAG> struct TagWidth;
+  template<size_t W> struct TagWidth<emp::BitSet<W>> { static constexpr size_t value = W; };
+
+  /// Smallest unsigned integer type that can hold a W-bit tag.
+  template<size_t W>
+  using packed_tag_t = typename std::conditional<(W <= 16), uint16_t,
+                         typename std::conditional<(W <= 32), uint32_t, uint64_t>::type>::type;
+
+  /// Pack a tag (up to 64 bits wide) into a single integer.
+  template<size_t W>
+  packed_tag_t<W> PackTag(const emp::BitSet<W> & tag) {
+    static_assert(W <= 64, "PackTag only supports tags up to 64 bits wide.");
+    uint64_t packed = tag.GetUInt(0);
+    if (W > 32) packed |= ((uint64_t)tag.GetUInt(1)) << 32;
+    return (packed_tag_t<W>)packed;
+  }
+
+  /// Unpack a tag packed by PackTag.
+  template<size_t W>
+  void UnpackTag(uint64_t packed, emp::BitSet<W> & tag) {
+    static_assert(W <= 64, "UnpackTag only supports tags up to 64 bits wide.");
+    for (size_t i = 0; i < W; ++i) tag.Set(i, (packed >> i) & 1);
+  }
+
+  inline uint32_t PopCount(uint64_t x) { return (uint32_t)__builtin_popcountll(x); }
+
+  /// Count matching bits between query and each of n packed W-bit tags: out[i] = W - hamming(tags[i], query).
+  template<size_t W>
+  void CalcMatchCounts(const packed_tag_t<W> * tags, size_t n, packed_tag_t<W> query, uint32_t * out) {
+    for (size_t i = 0; i < n; ++i) out[i] = W - PopCount((uint64_t)(tags[i] ^ query));
+  }
+
+  #if defined(__SSSE3__)
+  /// 16-bit tags: popcount eight tags at a time with nibble lookups (SSSE3/AVX2), scalar for the remainder.
+  template<>
+  inline void CalcMatchCounts<16>(const uint16_t * tags, size_t n, uint16_t query, uint32_t * out) {
+    size_t i = 0;
+    #if defined(__AVX2__)
+    {
+      const __m256i q = _mm256_set1_epi16((short)query);
+      const __m256i lut = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4, 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+      const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+      const __m256i byte_mask = _mm256_set1_epi16(0x00ff);
+      alignas(32) uint16_t cnts[16];
+      for (; i + 16 <= n; i += 16) {
+        const __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(tags + i)), q);
+        const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, nibble_mask));
+        const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble_mask));
+        const __m256i cnt8 = _mm256_add_epi8(lo, hi);
+        const __m256i cnt16 = _mm256_add_epi16(_mm256_and_si256(cnt8, byte_mask), _mm256_srli_epi16(cnt8, 8));
+        _mm256_store_si256((__m256i*)cnts, cnt16);
+        for (size_t k = 0; k < 16; ++k) out[i + k] = 16 - cnts[k];
+      }
+    }
+    #endif
+    {
+      const __m128i q = _mm_set1_epi16((short)query);
+      const __m128i lut = _mm_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+      const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+      const __m128i byte_mask = _mm_set1_epi16(0x00ff);
+      alignas(16) uint16_t cnts[8];
+      for (; i + 8 <= n; i += 8) {
+        const __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(tags + i)), q);
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, nibble_mask));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), nibble_mask));
+        const __m128i cnt8 = _mm_add_epi8(lo, hi);
+        const __m128i cnt16 = _mm_add_epi16(_mm_and_si128(cnt8, byte_mask), _mm_srli_epi16(cnt8, 8));
+        _mm_store_si128((__m128i*)cnts, cnt16);
+        for (size_t k = 0; k < 8; ++k) out[i + k] = 16 - cnts[k];
+      }
+    }
+    for (; i < n; ++i) out[i] = 16 - PopCount((uint64_t)(tags[i] ^ query));
+  }
+  #endif
+
+  /// PackedTagSet stores a set of W-bit tags (e.g., all function tags of a program) contiguously,
+  /// and matches a query tag against all of them in one pass.
+  template<size_t W>
+  class PackedTagSet {
+    public:
+      using tag_t = emp::BitSet<W>;
+      using word_t = packed_tag_t<W>;
+
+    protected:
+      emp::vector<word_t> tags;
+      emp::vector<uint32_t> match_cnts;
+
+    public:
+      PackedTagSet() : tags(), match_cnts() { ; }
+
+      size_t GetSize() const { return tags.size(); }
+      void Clear() { tags.clear(); }
+      void Add(const tag_t & tag) { tags.emplace_back(PackTag<W>(tag)); }
+
+      /// Pack function tags of given program.
+      template<typename PROGRAM>
+      void PackFunctions(const PROGRAM & program) {
+        tags.resize(program.GetSize());
+        for (size_t fID = 0; fID < program.GetSize(); ++fID) tags[fID] = PackTag<W>(program.program[fID].affinity);
+      }
+
+      /// Number of matching bits between query and every tag in set.
+      const emp::vector<uint32_t> & CalcMatchCounts(const tag_t & query) {
+        match_cnts.resize(tags.size());
+        toolbelt::CalcMatchCounts<W>(tags.data(), tags.size(), PackTag<W>(query), match_cnts.data());
+        return match_cnts;
+      }
+
+      /// Find all tags with the best simple matching coefficient with query (at least thresh).
+      /// Same result as EventDrivenGP::FindBestFuncMatch when not using reference modifiers.
+      void FindBestMatch(const tag_t & query, double thresh, emp::vector<size_t> & best) {
+        best.clear();
+        CalcMatchCounts(query);
+        for (size_t i = 0; i < match_cnts.size(); ++i) {
+          const double bind = (double)match_cnts[i] / (double)W;
+          if (bind == thresh) best.emplace_back(i);
+          else if (bind > thresh) {
+            best.resize(1);
+            best[0] = i;
+            thresh = bind;
+          }
+        }
+      }
+  };
+
+  /// TagMatchCache memoizes FindBestFuncMatch results (query tag -> best matching functions) for
+  /// the program currently loaded on a single piece of hardware.
+  ///  - Clear() whenever a new program is loaded onto the hardware.
+  ///  - InvalidateRegulated() whenever function reference modifiers change. Only lookups that use
+  ///    reference modifiers are invalidated.
+  template<typename HARDWARE>
+  class TagMatchCache {
+    public:
+      using hardware_t = HARDWARE;
+      using tag_t = typename hardware_t::affinity_t;
+
+    protected:
+      struct Entry {
+        tag_t tag;
+        double thresh;
+        bool use_ref_mods;
+        size_t ref_mod_version;
+        emp::vector<size_t> matches;
+      };
+
+      std::unordered_map<size_t, Entry> entries;
+      size_t ref_mod_version;
+
+      PackedTagSet<TagWidth<tag_t>::value> func_tags; ///< Packed function tags (for lookups that don't use reference modifiers).
+      bool func_tags_valid;
+
+    public:
+      TagMatchCache() : entries(), ref_mod_version(0), func_tags(), func_tags_valid(false) { ; }
+
+      void Clear() { entries.clear(); ++ref_mod_version; func_tags_valid = false; }
+      void InvalidateRegulated() { ++ref_mod_version; }
+
+      size_t GetSize() const { return entries.size(); }
+
+      /// Equivalent to hw.FindBestFuncMatch(tag, thresh, use_ref_mods).
+      const emp::vector<size_t> & FindBestFuncMatch(hardware_t & hw, const tag_t & tag, double thresh, bool use_ref_mods) {
+        const size_t key = HashCombine(HashCombine(HashTag(tag), std::hash<double>()(thresh)), (size_t)use_ref_mods);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+          Entry & entry = it->second;
+          if (entry.tag == tag && entry.thresh == thresh && entry.use_ref_mods == use_ref_mods
+              && (!use_ref_mods || entry.ref_mod_version == ref_mod_version)) {
+            return entry.matches;
+          }
+        } else {
+          it = entries.emplace(key, Entry()).first;
+        }
+        // Cache miss (or stale entry): do the lookup.
+        Entry & entry = it->second;
+        entry.tag = tag;
+        entry.thresh = thresh;
+        entry.use_ref_mods = use_ref_mods;
+        entry.ref_mod_version = ref_mod_version;
+        if (use_ref_mods) {
+          entry.matches = hw.FindBestFuncMatch(tag, thresh, use_ref_mods);
+        } else {
+          if (!func_tags_valid) { func_tags.PackFunctions(hw.GetProgram()); func_tags_valid = true; }
+          func_tags.FindBestMatch(tag, thresh, entry.matches);
+        }
+        return entry.matches;
+      }
+
+      /// Find best matching function (ties broken randomly with hardware's random number generator).
+      /// Returns false if there is no matching function.
+      bool FindFunction(hardware_t & hw, const tag_t & tag, double thresh, bool use_ref_mods, size_t & fID) {
+        const emp::vector<size_t> & matches = FindBestFuncMatch(hw, tag, thresh, use_ref_mods);
+        if (matches.empty()) return false;
+        if (matches.size() == 1) fID = matches[0];
+        else fID = matches[hw.GetRandom().GetUInt(matches.size())];
+        return true;
+      }
+  };
+
+  /// FunctionUsage tracks which functions of a program were used (called or spawned) during a
+  /// trial: one bit per function ID (popcount gives the number used), plus optional per-function
+  /// call counts for profiling.
+  ///  - Sized for an expected maximum function count; marking a larger function ID grows it.
+  class FunctionUsage {
+    protected:
+      emp::vector<uint64_t> used;     ///< Bitmask over function IDs (64 per word)
+      emp::vector<size_t> call_cnts;  ///< Per-function call/spawn counts (if profiling)
+      bool profile;
+
+    public:
+      FunctionUsage(size_t max_func_cnt=64, bool _profile=false)
+        : used((max_func_cnt + 63) / 64, 0), call_cnts((_profile) ? max_func_cnt : 0, 0),
+          profile(_profile) { ; }
+
+      bool IsProfiling() const { return profile; }
+
+      /// Record a call to (or core spawned on) given function.
+      void Mark(size_t fID) {
+        const size_t word = fID >> 6;
+        if (word >= used.size()) used.resize(word + 1, 0);
+        used[word] |= ((uint64_t)1) << (fID & 63);
+        if (profile) {
+          if (fID >= call_cnts.size()) call_cnts.resize(fID + 1, 0);
+          ++call_cnts[fID];
+        }
+      }
+
+      bool IsUsed(size_t fID) const {
+        const size_t word = fID >> 6;
+        return (word < used.size()) && ((used[word] >> (fID & 63)) & 1);
+      }
+
+      /// Number of distinct functions used.
+      size_t GetUsedCnt() const {
+        size_t cnt = 0;
+        for (size_t i = 0; i < used.size(); ++i) cnt += PopCount(used[i]);
+        return cnt;
+      }
+
+      /// Calls/spawns per function ID (empty unless profiling).
+      const emp::vector<size_t> & GetCallCnts() const { return call_cnts; }
+
+      void Clear() {
+        std::fill(used.begin(), used.end(), 0);
+        std::fill(call_cnts.begin(), call_cnts.end(), 0);
+      }
+  };
+
+  /// RandomStreams derives independent, reproducible random number streams from a single
+  /// base seed. Streams are keyed by (generation, agent, trial): reseeding a generator from
+  /// a stream key (rather than continuing to draw from a shared generator) makes results
+  /// independent of the order in which agents/trials are evaluated.
+  class RandomStreams {
+    protected:
+      uint64_t base_seed;
+
+      /// SplitMix64 finalizer.
+      static uint64_t Mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+      }
+
+      static uint64_t Combine(uint64_t x, uint64_t key) {
+        return Mix(x ^ (key + 0x9e3779b97f4a7c15ULL));
+      }
+
+    public:
+      RandomStreams(uint64_t _base_seed=0) : base_seed(_base_seed) { ; }
+
+      uint64_t GetBaseSeed() const { return base_seed; }
+      void SetBaseSeed(uint64_t seed) { base_seed = seed; }
+
+      /// Get seed for stream identified by given key. Seed is always valid (positive) for emp::Random.
+      int GetSeed(size_t gen, size_t agent_id, size_t trial_id=0) const {
+        uint64_t x = Mix(base_seed);
+        x = Combine(x, (uint64_t)gen);
+        x = Combine(x, (uint64_t)agent_id);
+        x = Combine(x, (uint64_t)trial_id);
+        return (int)(x % 2147483646) + 1;
+      }
+
+      /// Reset given random number generator to the beginning of the specified stream.
+      void SeedStream(emp::Random & rnd, size_t gen, size_t agent_id, size_t trial_id=0) const {
+        rnd.ResetSeed(GetSeed(gen, agent_id, trial_id));
+      }
+  };
+
+  /// BernoulliSkipper samples sequences of independent Bernoulli(p) trials by skipping ahead:
+  /// rather than drawing once per trial, it draws the (geometrically distributed) number of
+  /// failures before the next success. Random draws are proportional to the number of successes.
+  class BernoulliSkipper {
+    protected:
+      double p;
+      double log_q;   ///< log(1 - p)
+
+    public:
+      BernoulliSkipper(double _p=0.0) : p(0.0), log_q(0.0) { SetP(_p); }
+
+      double GetP() const { return p; }
+      void SetP(double _p) {
+        p = _p;
+        log_q = (p > 0.0 && p < 1.0) ? std::log1p(-p) : 0.0;
+      }
+
+      /// Number of failures before the next success, capped at limit.
+      size_t Skip(emp::Random & rnd, size_t limit) const {
+        if (p <= 0.0) return limit;
+        if (p >= 1.0) return 0;
+        const double skip = std::floor(std::log(1.0 - rnd.GetDouble()) / log_q);
+        return (skip < (double)limit) ? (size_t)skip : limit;
+      }
+
+      /// Call fun(i) for each successful trial i in [0, n) (in increasing order).
+      template <typename FUN>
+      void ForEachSuccess(emp::Random & rnd, size_t n, FUN fun) const {
+        for (size_t i = Skip(rnd, n); i < n; i += 1 + Skip(rnd, n)) fun(i);
+      }
+
+      /// Number of successes in n trials (binomially distributed).
+      size_t Count(emp::Random & rnd, size_t n) const {
+        size_t cnt = 0;
+        ForEachSuccess(rnd, n, [&cnt](size_t) { ++cnt; });
+        return cnt;
+      }
+  };
+
+  /// CowPtr is a copy-on-write handle to a value: copies share one instance, and Edit() clones
+  /// the shared instance before handing out write access. Copies (e.g., offspring that end up
+  /// unmutated) cost a reference count increment instead of a deep copy.
+  ///  - Given an ObjectPool, instances are recycled through it (copies share the pool).
+  ///  - Get() references are invalidated by Edit() if the instance was shared.
+  ///  - Handles may be copied/edited from different threads, but a single handle must not be
+  ///    used concurrently.
+  template <typename T>
+  class CowPtr {
+    public:
+      using pool_t = ObjectPool<T>;
+
+    protected:
+      std::shared_ptr<T> ptr;
+      emp::Ptr<pool_t> pool;
+
+      std::shared_ptr<T> Make(const T & val) const {
+        return (pool != nullptr) ? pool->AcquireShared(val) : std::make_shared<T>(val);
+      }
+
+    public:
+      CowPtr() : ptr(), pool(nullptr) { ; }
+      explicit CowPtr(const T & val, emp::Ptr<pool_t> _pool=nullptr) : ptr(), pool(_pool) { ptr = Make(val); }
+      CowPtr(const CowPtr &) = default;
+      CowPtr(CowPtr &&) noexcept = default;
+      CowPtr & operator=(const CowPtr &) = default;
+      CowPtr & operator=(CowPtr &&) noexcept = default;
+
+      bool IsNull() const { return !ptr; }
+      bool IsShared() const { return ptr.use_count() > 1; }
+      size_t GetShareCnt() const { return (size_t)ptr.use_count(); }
+      emp::Ptr<pool_t> GetPool() const { return pool; }
+
+      const T & Get() const {
+        emp_assert(ptr);
+        return *ptr;
+      }
+
+      /// Write access; clones the instance first if any other handle shares it.
+      T & Edit() {
+        emp_assert(ptr);
+        if (ptr.use_count() > 1) ptr = Make(*ptr);
+        // Pairs with the release in other handles' reference count decrements, so their reads of
+        // the (now unshared) instance happen before our writes.
+        else std::atomic_thread_fence(std::memory_order_acquire);
+        return *ptr;
+      }
+
+      void Set(const T & val) { ptr = Make(val); }
+  };
+
   /// SignalGPMutator implements the standard mutation function that I use for 
   /// most SignalGP experiments.
   // TODO: 
@@ -126,6 +595,361 @@ namespace toolbelt {
       double PER_FUNC__FUNC_DUP_RATE;
       double PER_FUNC__FUNC_DEL_RATE;
 
+      bool legacy_mode; ///< Use original implementation (per-trial random draws, rebuilt functions)?
+
+      // Skip samplers for per-bit/per-instruction rates (kept in sync with rates by setters).
+      BernoulliSkipper bflip_skipper;
+      BernoulliSkipper sub_skipper;
+      BernoulliSkipper ins_skipper;
+      BernoulliSkipper del_skipper;
+
+      /// Slip-duplicate [begin:end) of given function, inserting the copy at end (in place).
+      static void SlipDuplicate(function_t & fun, size_t begin, size_t end) {
+        auto & seq = fun.inst_seq;
+        const size_t old_size = seq.size();
+        seq.reserve(old_size + (end - begin));
+        for (size_t i = begin; i < end; ++i) seq.emplace_back(seq[i]);
+        std::rotate(seq.begin() + end, seq.begin() + old_size, seq.end());
+      }
+
+      /// Slip-duplicate [begin:end) of given function by rebuilding it (original implementation).
+      static void SlipDuplicateLegacy(function_t & fun, size_t begin, size_t end) {
+        const size_t dup_size = end - begin;
+        const size_t new_size = fun.GetSize() + dup_size;
+        function_t new_fun(fun.GetAffinity());
+        for (size_t i = 0; i < new_size; ++i)
+        {
+          if (i < end)
+            new_fun.PushInst(fun[i]);
+          else
+            new_fun.PushInst(fun[i - dup_size]);
+        }
+        fun = new_fun;
+      }
+
+      /// Slip-delete [end:begin) of given function (in place).
+      static void SlipDelete(function_t & fun, size_t begin, size_t end) {
+        fun.inst_seq.erase(fun.inst_seq.begin() + end, fun.inst_seq.begin() + begin);
+      }
+
+      /// Slip-delete [end:begin) of given function by rebuilding it (original implementation).
+      static void SlipDeleteLegacy(function_t & fun, size_t begin, size_t end) {
+        function_t new_fun(fun.GetAffinity());
+        for (size_t i = 0; i < end; ++i)
+          new_fun.PushInst(fun[i]);
+        for (size_t i = begin; i < fun.GetSize(); ++i)
+          new_fun.PushInst(fun[i]);
+        fun = new_fun;
+      }
+
+      /// Random instruction for insertion mutations.
+      inst_t GetRandomInst(const program_t & program, emp::Random & rnd) const {
+        inst_t inst(rnd.GetUInt(program.GetInstLib()->GetSize()),
+                    rnd.GetInt(PROG_MAX_ARG_VAL),
+                    rnd.GetInt(PROG_MAX_ARG_VAL),
+                    rnd.GetInt(PROG_MAX_ARG_VAL),
+                    tag_t());
+        inst.affinity.Randomize(rnd);
+        return inst;
+      }
+
+      /// Program handle that edits a program_t directly (see CowPtr for the copy-on-write handle).
+      struct ProgramRef {
+        program_t & program;
+        const program_t & Get() const { return program; }
+        program_t & Edit() { return program; }
+      };
+
+      /// Apply num_ins insertions and skip-sampled per-instruction deletions to given function.
+      ///  - Deletion-only (the common case) compacts the function in place. With insertions, the
+      ///    result is built into a separate sequence and swapped in.
+      template <typename PROGRAM_HANDLE>
+      void InsertDelete(PROGRAM_HANDLE & program, size_t fID, int num_ins, emp::Random & rnd,
+                        size_t & expected_prog_len, size_t & mut_cnt) const {
+        const size_t old_size = program.Get().program[fID].inst_seq.size();
+        size_t expected_func_len = num_ins + old_size;
+        // Deletion candidates are independent of insertions; a candidate is deleted unless doing so
+        // would shrink the function below minimum length.
+        emp::vector<size_t> del_locs;
+        del_skipper.ForEachSuccess(rnd, old_size, [&](size_t i) {
+          if (expected_func_len > PROG_MIN_FUNC_LEN) {
+            del_locs.emplace_back(i);
+            ++mut_cnt;
+            --expected_prog_len;
+            --expected_func_len;
+          }
+        });
+        if (num_ins <= 0) {
+          if (del_locs.empty()) return;
+          auto & seq = program.Edit().program[fID].inst_seq;
+          size_t whead = del_locs[0];
+          size_t next_del = 1;
+          for (size_t rhead = del_locs[0] + 1; rhead < old_size; ++rhead) {
+            if (next_del < del_locs.size() && del_locs[next_del] == rhead) { ++next_del; continue; }
+            seq[whead++] = seq[rhead];
+          }
+          seq.resize(whead);
+          return;
+        }
+        auto & seq = program.Edit().program[fID].inst_seq;
+        emp::vector<size_t> ins_locs = emp::RandomUIntVector(rnd, num_ins, 0, old_size);
+        std::sort(ins_locs.begin(), ins_locs.end());
+        emp::vector<inst_t> new_seq;
+        new_seq.reserve(expected_func_len);
+        size_t next_ins = 0, next_del = 0;
+        for (size_t rhead = 0; rhead < old_size; ++rhead) {
+          while (next_ins < ins_locs.size() && ins_locs[next_ins] <= rhead) {
+            new_seq.emplace_back(GetRandomInst(program.Get(), rnd));
+            ++mut_cnt;
+            ++next_ins;
+          }
+          if (next_del < del_locs.size() && del_locs[next_del] == rhead) { ++next_del; continue; }
+          new_seq.emplace_back(seq[rhead]);
+        }
+        seq.swap(new_seq);
+      }
+
+      /// Apply mutations to a single function, skip-sampling per-bit/per-instruction mutations:
+      /// tag bits (function affinity, then each instruction's affinity) form one index space, and
+      /// substitution sites (each instruction's ID, then its arguments) form another.
+      ///  - Reads go through program.Get() and writes through program.Edit(), so a copy-on-write
+      ///    program is only copied if a mutation actually lands.
+      template <typename PROGRAM_HANDLE>
+      void MutateFunction(PROGRAM_HANDLE & program, size_t fID, emp::Random & rnd,
+                          size_t & expected_prog_len, size_t & mut_cnt) const {
+        auto fun_size = [&program, fID]() { return program.Get().program[fID].inst_seq.size(); };
+        auto edit_fun = [&program, fID]() -> function_t & { return program.Edit().program[fID]; };
+
+        // Slip-mutation?
+        if (rnd.P(PER_FUNC__SLIP_RATE))
+        {
+          uint32_t begin = rnd.GetUInt(fun_size());
+          uint32_t end = rnd.GetUInt(fun_size());
+          const bool dup = begin < end;
+          const bool del = begin > end;
+          const int dup_size = end - begin;
+          const int del_size = begin - end;
+          if (dup && (expected_prog_len + dup_size <= PROG_MAX_TOTAL_LEN) && (fun_size() + dup_size <= PROG_MAX_FUNC_LEN))
+          {
+            SlipDuplicate(edit_fun(), begin, end);
+            ++mut_cnt;
+            expected_prog_len += dup_size;
+          }
+          else if (del && ((fun_size() - del_size) >= PROG_MIN_FUNC_LEN))
+          {
+            SlipDelete(edit_fun(), begin, end);
+            ++mut_cnt;
+            expected_prog_len -= del_size;
+          }
+        }
+
+        // Tag bit flips.
+        const size_t fun_len = fun_size();
+        const size_t tag_width = program.Get().program[fID].affinity.GetSize();
+        bflip_skipper.ForEachSuccess(rnd, tag_width * (1 + fun_len), [&](size_t i) {
+          function_t & fun = edit_fun();
+          tag_t & aff = (i < tag_width) ? fun.affinity : fun.inst_seq[i / tag_width - 1].affinity;
+          const size_t bit = i % tag_width;
+          aff.Set(bit, !aff.Get(bit));
+          ++mut_cnt;
+        });
+
+        // Substitutions (instruction ID and arguments, even if they aren't relevant to instruction).
+        constexpr size_t SITES_PER_INST = 1 + hardware_t::MAX_INST_ARGS;
+        sub_skipper.ForEachSuccess(rnd, SITES_PER_INST * fun_len, [&](size_t i) {
+          inst_t & inst = edit_fun().inst_seq[i / SITES_PER_INST];
+          const size_t site = i % SITES_PER_INST;
+          if (site == 0) inst.id = rnd.GetUInt(program.Get().GetInstLib()->GetSize());
+          else inst.args[site - 1] = rnd.GetInt(PROG_MAX_ARG_VAL);
+          ++mut_cnt;
+        });
+
+        // Insertion/deletion mutations?
+        int num_ins = ins_skipper.Count(rnd, fun_len);
+        // Ensure that insertions don't exceed maximum program length.
+        if ((num_ins + fun_len) > PROG_MAX_FUNC_LEN) num_ins = PROG_MAX_FUNC_LEN - fun_len;
+        if ((num_ins + expected_prog_len) > PROG_MAX_TOTAL_LEN) num_ins = PROG_MAX_TOTAL_LEN - expected_prog_len;
+        expected_prog_len += num_ins;
+        InsertDelete(program, fID, num_ins, rnd, expected_prog_len, mut_cnt);
+      }
+
+      /// Apply insertions/deletions by rebuilding the function (original implementation).
+      void InsertDeleteLegacy(program_t & program, function_t & fun, int num_ins, emp::Random & rnd,
+                              size_t & expected_prog_len, size_t & mut_cnt) const {
+        size_t expected_func_len = num_ins + fun.GetSize();
+        // Compute insertion locations and sort them.
+        emp::vector<size_t> ins_locs = emp::RandomUIntVector(rnd, num_ins, 0, fun.GetSize());
+        if (ins_locs.size())
+          std::sort(ins_locs.begin(), ins_locs.end(), std::greater<size_t>());
+        function_t new_fun(fun.GetAffinity());
+        size_t rhead = 0;
+        while (rhead < fun.GetSize())
+        {
+          if (ins_locs.size())
+          {
+            if (rhead >= ins_locs.back())
+            {
+              // Insert a random instruction.
+              new_fun.PushInst(rnd.GetUInt(program.GetInstLib()->GetSize()),
+                              rnd.GetInt(PROG_MAX_ARG_VAL),
+                              rnd.GetInt(PROG_MAX_ARG_VAL),
+                              rnd.GetInt(PROG_MAX_ARG_VAL),
+                              tag_t());
+              new_fun.inst_seq.back().affinity.Randomize(rnd);
+              ++mut_cnt;
+              ins_locs.pop_back();
+              continue;
+            }
+          }
+          // Do we delete this instruction?
+          if (rnd.P(PER_INST__DEL_RATE) && (expected_func_len > PROG_MIN_FUNC_LEN))
+          {
+            ++mut_cnt;
+            --expected_prog_len;
+            --expected_func_len;
+          }
+          else
+          {
+            new_fun.PushInst(fun[rhead]);
+          }
+          ++rhead;
+        }
+        fun = new_fun;
+      }
+
+      /// Apply mutations to a single function (original implementation).
+      void MutateFunctionLegacy(program_t & program, size_t fID, emp::Random & rnd,
+                                size_t & expected_prog_len, size_t & mut_cnt) const {
+        // Mutate affinity
+        for (size_t i = 0; i < program[fID].GetAffinity().GetSize(); ++i)
+        {
+          tag_t &aff = program[fID].GetAffinity();
+          if (rnd.P(PER_BIT__TAG_BFLIP_RATE))
+          {
+            ++mut_cnt;
+            aff.Set(i, !aff.Get(i));
+          }
+        }
+
+        // Slip-mutation?
+        if (rnd.P(PER_FUNC__SLIP_RATE))
+        {
+          uint32_t begin = rnd.GetUInt(program[fID].GetSize());
+          uint32_t end = rnd.GetUInt(program[fID].GetSize());
+          const bool dup = begin < end;
+          const bool del = begin > end;
+          const int dup_size = end - begin;
+          const int del_size = begin - end;
+          // If we would be duplicating and the result will not exceed maximum program length, duplicate!
+          if (dup && (expected_prog_len + dup_size <= PROG_MAX_TOTAL_LEN) && (program[fID].GetSize() + dup_size <= PROG_MAX_FUNC_LEN))
+          {
+            // duplicate begin:end
+            SlipDuplicateLegacy(program[fID], begin, end);
+            ++mut_cnt;
+            expected_prog_len += dup_size;
+          }
+          else if (del && ((program[fID].GetSize() - del_size) >= PROG_MIN_FUNC_LEN))
+          {
+            // delete end:begin
+            SlipDeleteLegacy(program[fID], begin, end);
+            ++mut_cnt;
+            expected_prog_len -= del_size;
+          }
+        }
+
+        // Substitution mutations? (pretty much completely safe)
+        for (size_t i = 0; i < program[fID].GetSize(); ++i)
+        {
+          inst_t &inst = program[fID][i];
+          // Mutate affinity (even when it doesn't use it).
+          for (size_t k = 0; k < inst.affinity.GetSize(); ++k)
+          {
+            if (rnd.P(PER_BIT__TAG_BFLIP_RATE))
+            {
+              ++mut_cnt;
+              inst.affinity.Set(k, !inst.affinity.Get(k));
+            }
+          }
+
+          // Mutate instruction.
+          if (rnd.P(PER_INST__SUB_RATE))
+          {
+            ++mut_cnt;
+            inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
+          }
+
+          // Mutate arguments (even if they aren't relevent to instruction).
+          for (size_t k = 0; k < hardware_t::MAX_INST_ARGS; ++k)
+          {
+            if (rnd.P(PER_INST__SUB_RATE))
+            {
+              ++mut_cnt;
+              inst.args[k] = rnd.GetInt(PROG_MAX_ARG_VAL);
+            }
+          }
+        }
+
+        // Insertion/deletion mutations?
+        // - Compute number of insertions.
+        int num_ins = rnd.GetRandBinomial(program[fID].GetSize(), PER_INST__INS_RATE);
+        // Ensure that insertions don't exceed maximum program length.
+        if ((num_ins + program[fID].GetSize()) > PROG_MAX_FUNC_LEN)
+        {
+          num_ins = PROG_MAX_FUNC_LEN - program[fID].GetSize();
+        }
+        if ((num_ins + expected_prog_len) > PROG_MAX_TOTAL_LEN)
+        {
+          num_ins = PROG_MAX_TOTAL_LEN - expected_prog_len;
+        }
+        expected_prog_len += num_ins;
+
+        // Do we need to do any insertions or deletions?
+        if (num_ins > 0 || PER_INST__DEL_RATE > 0.0)
+        {
+          InsertDeleteLegacy(program, program[fID], num_ins, rnd, expected_prog_len, mut_cnt);
+        }
+      }
+
+      /// Apply mutations to program (through given program handle).
+      template <typename PROGRAM_HANDLE>
+      size_t MutateProgram(PROGRAM_HANDLE & program, emp::Random & rnd) {
+        size_t mut_cnt = 0;
+        size_t expected_prog_len = program.Get().GetInstCnt();
+
+        // Duplicate a (single) function?
+        if (rnd.P(PER_FUNC__FUNC_DUP_RATE) && program.Get().GetSize() < PROG_MAX_FUNC_CNT)
+        {
+          const uint32_t fID = rnd.GetUInt(program.Get().GetSize());
+          // Would function duplication make expected program length exceed max?
+          if (expected_prog_len + program.Get().program[fID].inst_seq.size() <= PROG_MAX_TOTAL_LEN)
+          {
+            program_t & prog = program.Edit();
+            prog.PushFunction(prog[fID]);
+            expected_prog_len += prog[fID].GetSize();
+            ++mut_cnt;
+          }
+        }
+
+        // Delete a (single) function?
+        if (rnd.P(PER_FUNC__FUNC_DEL_RATE) && program.Get().GetSize() > PROG_MIN_FUNC_CNT)
+        {
+          const uint32_t fID = rnd.GetUInt(program.Get().GetSize());
+          program_t & prog = program.Edit();
+          expected_prog_len -= prog[fID].GetSize();
+          prog[fID] = prog[prog.GetSize() - 1];
+          prog.program.resize(prog.GetSize() - 1);
+          ++mut_cnt;
+        }
+
+        // For each function...
+        for (size_t fID = 0; fID < program.Get().GetSize(); ++fID)
+        {
+          if (legacy_mode) MutateFunctionLegacy(program.Edit(), fID, rnd, expected_prog_len, mut_cnt);
+          else MutateFunction(program, fID, rnd, expected_prog_len, mut_cnt);
+        }
+        return mut_cnt;
+      }
+
     public:
       SignalGPMutator(size_t _PROG_MIN_FUNC_CNT=1,
                       size_t _PROG_MAX_FUNC_CNT=8,
@@ -152,7 +976,12 @@ namespace toolbelt {
           PER_INST__DEL_RATE(_PER_INST__DEL_RATE),
           PER_FUNC__SLIP_RATE(_PER_FUNC__SLIP_RATE),
           PER_FUNC__FUNC_DUP_RATE(_PER_FUNC__FUNC_DUP_RATE),
-          PER_FUNC__FUNC_DEL_RATE(_PER_FUNC__FUNC_DEL_RATE) 
+          PER_FUNC__FUNC_DEL_RATE(_PER_FUNC__FUNC_DEL_RATE),
+          legacy_mode(false),
+          bflip_skipper(_PER_BIT__TAG_BFLIP_RATE),
+          sub_skipper(_PER_INST__SUB_RATE),
+          ins_skipper(_PER_INST__INS_RATE),
+          del_skipper(_PER_INST__DEL_RATE)
       { ; }
 
       ~SignalGPMutator() { ; }
@@ -170,6 +999,7 @@ namespace toolbelt {
       double GetPerFuncSlipRate() const { return PER_FUNC__SLIP_RATE; }
       double GetPerFuncDupRate() const { return PER_FUNC__FUNC_DUP_RATE; }
       double GetPerFuncDelRate() const { return PER_FUNC__FUNC_DEL_RATE; }
+      bool GetLegacyMode() const { return legacy_mode; }
 
       // TODO: add value guards/emp_asserts!
       void SetProgMinFuncCnt(size_t val) { PROG_MIN_FUNC_CNT = val; }
@@ -178,187 +1008,43 @@ namespace toolbelt {
       void SetProgMaxFuncLen(size_t val) { PROG_MAX_FUNC_LEN = val; }
       void SetProgMaxTotalLen(size_t val) { PROG_MAX_TOTAL_LEN = val; }
       void SetProgMaxArgVal(int val) { PROG_MAX_ARG_VAL = val; }
-      void SetPerBitTagBitFlipRate(double val) { PER_BIT__TAG_BFLIP_RATE = val; }
-      void SetPerInstSubRate(double val) { PER_INST__SUB_RATE = val; }
-      void SetPerInstInsRate(double val) { PER_INST__INS_RATE = val; }
-      void SetPerInstDelRate(double val) { PER_INST__DEL_RATE = val; }
+      void SetPerBitTagBitFlipRate(double val) { PER_BIT__TAG_BFLIP_RATE = val; bflip_skipper.SetP(val); }
+      void SetPerInstSubRate(double val) { PER_INST__SUB_RATE = val; sub_skipper.SetP(val); }
+      void SetPerInstInsRate(double val) { PER_INST__INS_RATE = val; ins_skipper.SetP(val); }
+      void SetPerInstDelRate(double val) { PER_INST__DEL_RATE = val; del_skipper.SetP(val); }
       void SetPerFuncSlipRate(double val) { PER_FUNC__SLIP_RATE = val; }
       void SetPerFuncDupRate(double val) { PER_FUNC__FUNC_DUP_RATE = val; }
       void SetPerFuncDelRate(double val) { PER_FUNC__FUNC_DEL_RATE = val; }
+      /// Legacy mode is the original implementation: one random draw per tag bit/substitution site/
+      /// instruction, and mutated functions are rebuilt from scratch. Default mode skip-samples
+      /// (same mutation distribution, far fewer random draws) and mutates in place, so use legacy
+      /// mode to reproduce runs made before skip sampling.
+      void SetLegacyMode(bool val) { legacy_mode = val; }
 
-      size_t ApplyMutations(program_t & program, emp::Random & rnd) {
-        size_t mut_cnt = 0;
-        size_t expected_prog_len = program.GetInstCnt();
-
-        // Duplicate a (single) function?
-        if (rnd.P(PER_FUNC__FUNC_DUP_RATE) && program.GetSize() < PROG_MAX_FUNC_CNT)
-        {
-          const uint32_t fID = rnd.GetUInt(program.GetSize());
-          // Would function duplication make expected program length exceed max?
-          if (expected_prog_len + program[fID].GetSize() <= PROG_MAX_TOTAL_LEN)
-          {
-            program.PushFunction(program[fID]);
-            expected_prog_len += program[fID].GetSize();
-            ++mut_cnt;
-          }
-        }
-
-        // Delete a (single) function?
-        if (rnd.P(PER_FUNC__FUNC_DEL_RATE) && program.GetSize() > PROG_MIN_FUNC_CNT)
-        {
-          const uint32_t fID = rnd.GetUInt(program.GetSize());
-          expected_prog_len -= program[fID].GetSize();
-          program[fID] = program[program.GetSize() - 1];
-          program.program.resize(program.GetSize() - 1);
-          ++mut_cnt;
-        }
-
-        // For each function...
-        for (size_t fID = 0; fID < program.GetSize(); ++fID)
-        {
-
-          // Mutate affinity
-          for (size_t i = 0; i < program[fID].GetAffinity().GetSize(); ++i)
-          {
-            tag_t &aff = program[fID].GetAffinity();
-            if (rnd.P(PER_BIT__TAG_BFLIP_RATE))
-            {
-              ++mut_cnt;
-              aff.Set(i, !aff.Get(i));
-            }
-          }
-
-          // Slip-mutation?
-          if (rnd.P(PER_FUNC__SLIP_RATE))
-          {
-            uint32_t begin = rnd.GetUInt(program[fID].GetSize());
-            uint32_t end = rnd.GetUInt(program[fID].GetSize());
-            const bool dup = begin < end;
-            const bool del = begin > end;
-            const int dup_size = end - begin;
-            const int del_size = begin - end;
-            // If we would be duplicating and the result will not exceed maximum program length, duplicate!
-            if (dup && (expected_prog_len + dup_size <= PROG_MAX_TOTAL_LEN) && (program[fID].GetSize() + dup_size <= PROG_MAX_FUNC_LEN))
-            {
-              // duplicate begin:end
-              const size_t new_size = program[fID].GetSize() + (size_t)dup_size;
-              function_t new_fun(program[fID].GetAffinity());
-              for (size_t i = 0; i < new_size; ++i)
-              {
-                if (i < end)
-                  new_fun.PushInst(program[fID][i]);
-                else
-                  new_fun.PushInst(program[fID][i - dup_size]);
-              }
-              program[fID] = new_fun;
-              ++mut_cnt;
-              expected_prog_len += dup_size;
-            }
-            else if (del && ((program[fID].GetSize() - del_size) >= PROG_MIN_FUNC_LEN))
-            {
-              // delete end:begin
-              function_t new_fun(program[fID].GetAffinity());
-              for (size_t i = 0; i < end; ++i)
-                new_fun.PushInst(program[fID][i]);
-              for (size_t i = begin; i < program[fID].GetSize(); ++i)
-                new_fun.PushInst(program[fID][i]);
-              program[fID] = new_fun;
-              ++mut_cnt;
-              expected_prog_len -= del_size;
-            }
-          }
-
-          // Substitution mutations? (pretty much completely safe)
-          for (size_t i = 0; i < program[fID].GetSize(); ++i)
-          {
-            inst_t &inst = program[fID][i];
-            // Mutate affinity (even when it doesn't use it).
-            for (size_t k = 0; k < inst.affinity.GetSize(); ++k)
-            {
-              if (rnd.P(PER_BIT__TAG_BFLIP_RATE))
-              {
-                ++mut_cnt;
-                inst.affinity.Set(k, !inst.affinity.Get(k));
-              }
-            }
-
-            // Mutate instruction.
-            if (rnd.P(PER_INST__SUB_RATE))
-            {
-              ++mut_cnt;
-              inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
-            }
+      /// Apply mutations to program using the given stream. (rnd is reseeded to the start of the stream)
+      size_t ApplyMutations(program_t & program, emp::Random & rnd, const RandomStreams & streams, 
+                            size_t gen, size_t agent_id) {
+        streams.SeedStream(rnd, gen, agent_id);
+        return ApplyMutations(program, rnd);
+      }
 
-            // Mutate arguments (even if they aren't relevent to instruction).
-            for (size_t k = 0; k < hardware_t::MAX_INST_ARGS; ++k)
-            {
-              if (rnd.P(PER_INST__SUB_RATE))
-              {
-                ++mut_cnt;
-                inst.args[k] = rnd.GetInt(PROG_MAX_ARG_VAL);
-              }
-            }
-          }
+      size_t ApplyMutations(program_t & program, emp::Random & rnd) {
+        ProgramRef ref{program};
+        return MutateProgram(ref, rnd);
+      }
 
-          // Insertion/deletion mutations?
-          // - Compute number of insertions.
-          int num_ins = rnd.GetRandBinomial(program[fID].GetSize(), PER_INST__INS_RATE);
-          // Ensure that insertions don't exceed maximum program length.
-          if ((num_ins + program[fID].GetSize()) > PROG_MAX_FUNC_LEN)
-          {
-            num_ins = PROG_MAX_FUNC_LEN - program[fID].GetSize();
-          }
-          if ((num_ins + expected_prog_len) > PROG_MAX_TOTAL_LEN)
-          {
-            num_ins = PROG_MAX_TOTAL_LEN - expected_prog_len;
-          }
-          expected_prog_len += num_ins;
+      /// Apply mutations to a copy-on-write program, using the given stream.
+      size_t ApplyMutations(CowPtr<program_t> & program, emp::Random & rnd, const RandomStreams & streams,
+                            size_t gen, size_t agent_id) {
+        streams.SeedStream(rnd, gen, agent_id);
+        return ApplyMutations(program, rnd);
+      }
 
-          // Do we need to do any insertions or deletions?
-          if (num_ins > 0 || PER_INST__DEL_RATE > 0.0)
-          {
-            size_t expected_func_len = num_ins + program[fID].GetSize();
-            // Compute insertion locations and sort them.
-            emp::vector<size_t> ins_locs = emp::RandomUIntVector(rnd, num_ins, 0, program[fID].GetSize());
-            if (ins_locs.size())
-              std::sort(ins_locs.begin(), ins_locs.end(), std::greater<size_t>());
-            function_t new_fun(program[fID].GetAffinity());
-            size_t rhead = 0;
-            while (rhead < program[fID].GetSize())
-            {
-              if (ins_locs.size())
-              {
-                if (rhead >= ins_locs.back())
-                {
-                  // Insert a random instruction.
-                  new_fun.PushInst(rnd.GetUInt(program.GetInstLib()->GetSize()),
-                                  rnd.GetInt(PROG_MAX_ARG_VAL),
-                                  rnd.GetInt(PROG_MAX_ARG_VAL),
-                                  rnd.GetInt(PROG_MAX_ARG_VAL),
-                                  tag_t());
-                  new_fun.inst_seq.back().affinity.Randomize(rnd);
-                  ++mut_cnt;
-                  ins_locs.pop_back();
-                  continue;
-                }
-              }
-              // Do we delete this instruction?
-              if (rnd.P(PER_INST__DEL_RATE) && (expected_func_len > PROG_MIN_FUNC_LEN))
-              {
-                ++mut_cnt;
-                --expected_prog_len;
-                --expected_func_len;
-              }
-              else
-              {
-                new_fun.PushInst(program[fID][rhead]);
-              }
-              ++rhead;
-            }
-            program[fID] = new_fun;
-          }
-        }
-        return mut_cnt;
+      /// Apply mutations to a copy-on-write program: the program is only copied (if shared) when a
+      /// mutation lands, so unmutated offspring keep sharing their parent's program. (Legacy mode
+      /// always copies.)
+      size_t ApplyMutations(CowPtr<program_t> & program, emp::Random & rnd) {
+        return MutateProgram(program, rnd);
       }
 
   };